@@ -0,0 +1,308 @@
+#!/usr/bin/perl
+
+# Generates synthetic C, C++, Fortran or UPC input files for measuring how
+# edg44-pdt_roseparse scales with input size.
+#
+# Usage: gencorpus.pl --lang=c|cxx|fortran|upc [options] -o <file>
+#
+#   --routines=N        routines (default 50)
+#   --statements=N      statements per routine body (default 20)
+#   --depth=N           nesting depth of loops and conditionals (default 3)
+#   --templates=N       class and function templates, C++ only (default 5)
+#   --instantiations=N  instantiations per template, C++ only (default 4)
+#   --classes=N         classes derived from a common base; structs in C
+#                       and UPC, derived types in Fortran (default 10)
+#   --enums=N           enumerations (default 5)
+#   --macros=N          macro definitions, not in Fortran (default 20)
+#   --comments=N        comments (default 50)
+#   --scale=N           multiplies routines, templates, classes, enums,
+#                       macros and comments (default 1)
+#
+# Every routine calls the one before it, so the call graph grows with the
+# number of routines.
+
+use strict;
+use warnings;
+use Getopt::Long;
+
+my %opt = (
+    lang => 'c',
+    routines => 50,
+    statements => 20,
+    depth => 3,
+    templates => 5,
+    instantiations => 4,
+    classes => 10,
+    enums => 5,
+    macros => 20,
+    comments => 50,
+    scale => 1,
+    output => '-',
+);
+
+GetOptions(\%opt, 'lang=s', 'routines=i', 'statements=i', 'depth=i', 'templates=i',
+           'instantiations=i', 'classes=i', 'enums=i', 'macros=i', 'comments=i',
+           'scale=i', 'output|o=s')
+    or die "Usage: $0 --lang=c|cxx|fortran|upc [options] -o <file>\n";
+
+foreach my $k (qw(routines templates classes enums macros comments)) {
+    $opt{$k} *= $opt{scale};
+}
+
+my $lang = $opt{lang};
+die "Unknown language '$lang'\n" unless $lang =~ /^(c|cxx|fortran|upc)$/;
+
+my @out;
+my $commentsLeft = $opt{comments};
+
+# Spreads the requested comments over the file, one per call.
+sub comment {
+    my ($indent, $text) = @_;
+    return () if $commentsLeft <= 0;
+    $commentsLeft--;
+    return ($lang eq 'fortran') ? ("$indent! $text") : ("$indent/* $text */");
+}
+
+# ---------------------------------------------------------------------------
+# C-like languages (C, C++, UPC)
+# ---------------------------------------------------------------------------
+
+my $tmpCounter = 0;
+
+# Emits $count statements nested up to $depth levels deep. $first offsets
+# the statement mix; nested blocks use it so that each contains only one
+# further nested construct. Declarations open a block so the output is
+# valid C89.
+sub cBlock {
+    my ($indent, $depth, $count, $routine, $first) = @_;
+    my @lines;
+    for (my $i = 0; $i < $count; $i++) {
+        my $v = "v" . $tmpCounter++;
+        my $kind = ($i + ($first || 0)) % 7;
+        if ($depth > 0 && $kind == 0) {
+            push @lines, "${indent}{";
+            push @lines, "${indent}    int $v;";
+            push @lines, "${indent}    for ($v = 0; $v < n; $v++) {";
+            push @lines, cBlock("$indent        ", $depth - 1, 3, $routine, 5);
+            push @lines, "${indent}    }";
+            push @lines, "${indent}}";
+        } elsif ($depth > 0 && $kind == 1) {
+            push @lines, "${indent}if (acc > $i) {";
+            push @lines, cBlock("$indent    ", $depth - 1, 2, $routine, 5);
+            push @lines, "${indent}} else {";
+            push @lines, "${indent}    acc -= $i;";
+            push @lines, "${indent}}";
+        } elsif ($depth > 0 && $kind == 2) {
+            push @lines, "${indent}while (acc > $i * 100) {";
+            push @lines, cBlock("$indent    ", $depth - 1, 2, $routine, 5);
+            push @lines, "${indent}    acc /= 2;";
+            push @lines, "${indent}}";
+        } elsif ($kind == 3) {
+            push @lines, "${indent}switch (acc % 3) {";
+            push @lines, "${indent}case 0: acc += 1; break;";
+            push @lines, "${indent}case 1: acc += 2; break;";
+            push @lines, "${indent}default: break;";
+            push @lines, "${indent}}";
+        } elsif ($kind == 4 && $routine > 0) {
+            push @lines, "${indent}acc += f" . ($routine - 1) . "(acc, n - 1);";
+        } elsif ($kind == 5) {
+            push @lines, "${indent}{";
+            push @lines, "${indent}    int $v = acc * $i;";
+            push @lines, "${indent}    acc += $v;";
+            push @lines, "${indent}}";
+        } else {
+            push @lines, "${indent}acc = acc * 3 + $i;";
+        }
+    }
+    return @lines;
+}
+
+sub cLike {
+    my $cxx = ($lang eq 'cxx');
+    my $upc = ($lang eq 'upc');
+
+    push @out, "#include <upc.h>" if $upc;
+    for (my $i = 0; $i < $opt{macros}; $i++) {
+        push @out, "#define MACRO_$i(x) ((x) + $i)";
+    }
+    push @out, "";
+
+    for (my $i = 0; $i < $opt{enums}; $i++) {
+        push @out, comment("", "enumeration $i");
+        push @out, "enum color$i { " . join(", ", map { "color${i}_$_" } 0 .. 7) . " };";
+    }
+    push @out, "";
+
+    if ($cxx) {
+        push @out, "namespace bench {";
+        push @out, "class Base {";
+        push @out, "public:";
+        push @out, "    virtual ~Base() {}";
+        push @out, "    virtual int value(int x) const = 0;";
+        push @out, "protected:";
+        push @out, "    int base;";
+        push @out, "};";
+        for (my $i = 0; $i < $opt{classes}; $i++) {
+            push @out, comment("", "class $i");
+            push @out, "class Derived$i : public Base {";
+            push @out, "public:";
+            push @out, "    Derived$i() : field$i($i) {}";
+            push @out, "    int value(int x) const { return x + field$i; }";
+            push @out, "    static int count;";
+            push @out, "private:";
+            push @out, "    int field$i;";
+            push @out, "    enum color" . ($i % ($opt{enums} || 1)) . " color;" if $opt{enums} > 0;
+            push @out, "};";
+        }
+        for (my $i = 0; $i < $opt{templates}; $i++) {
+            push @out, comment("", "template $i");
+            push @out, "template <typename T, int N>";
+            push @out, "struct Array$i {";
+            push @out, "    T data[N];";
+            push @out, "    T get(int k) const { return data[k % N]; }";
+            push @out, "    void set(int k, T v) { data[k % N] = v; }";
+            push @out, "};";
+            push @out, "template <typename T>";
+            push @out, "T maximum$i(T a, T b) { return a > b ? a : b; }";
+            my @types = ('int', 'long', 'double', 'float', 'short', 'char', 'unsigned', 'long long');
+            for (my $j = 0; $j < $opt{instantiations}; $j++) {
+                my $t = $types[$j % @types];
+                my $n = $j + 1;
+                push @out, "template struct Array$i<$t, $n>;";
+                push @out, "template $t maximum$i<$t>($t, $t);";
+            }
+        }
+        push @out, "}";
+        push @out, "";
+    } else {
+        for (my $i = 0; $i < $opt{classes}; $i++) {
+            push @out, comment("", "struct $i");
+            my $prev = $i > 0 ? "    struct record" . ($i - 1) . " *prev;" : "    int first;";
+            push @out, "struct record$i {";
+            push @out, "    int field$i;";
+            push @out, "    double weight;";
+            push @out, $prev;
+            push @out, "};";
+        }
+        push @out, "";
+    }
+
+    if ($upc) {
+        push @out, "shared int counters[THREADS];";
+        push @out, "";
+    }
+
+    for (my $r = 0; $r < $opt{routines}; $r++) {
+        push @out, comment("", "routine $r");
+        push @out, "int f$r(int acc, int n) {";
+        push @out, "    if (n <= 0) return acc;";
+        push @out, cBlock("    ", $opt{depth}, $opt{statements}, $r);
+        if ($upc && $r % 4 == 0) {
+            push @out, "    {";
+            push @out, "    int t;";
+            push @out, "    upc_forall (t = 0; t < THREADS; t++; t) {";
+            push @out, "        counters[t] += acc;";
+            push @out, "    }";
+            push @out, "    upc_barrier;";
+            push @out, "    }";
+        }
+        push @out, "    return MACRO_" . ($r % $opt{macros}) . "(acc);" if $opt{macros} > 0;
+        push @out, "    return acc;" if $opt{macros} == 0;
+        push @out, "}";
+        push @out, "";
+    }
+
+    push @out, "int main(void) {";
+    if ($cxx && $opt{classes} > 0) {
+        push @out, "    bench::Derived0 d;";
+        push @out, "    return d.value(f" . ($opt{routines} - 1) . "(0, 3));";
+    } elsif ($opt{routines} > 0) {
+        push @out, "    return f" . ($opt{routines} - 1) . "(0, 3);";
+    } else {
+        push @out, "    return 0;";
+    }
+    push @out, "}";
+}
+
+# ---------------------------------------------------------------------------
+# Fortran
+# ---------------------------------------------------------------------------
+
+sub fBlock {
+    my ($indent, $depth, $count, $routine, $first) = @_;
+    my @lines;
+    for (my $i = 0; $i < $count; $i++) {
+        my $kind = ($i + ($first || 0)) % 6;
+        if ($depth > 0 && $kind == 0) {
+            push @lines, "${indent}do i$depth = 1, n";
+            push @lines, fBlock("$indent  ", $depth - 1, 3, $routine, 4);
+            push @lines, "${indent}end do";
+        } elsif ($depth > 0 && $kind == 1) {
+            push @lines, "${indent}if (acc > $i) then";
+            push @lines, fBlock("$indent  ", $depth - 1, 2, $routine, 4);
+            push @lines, "${indent}else";
+            push @lines, "${indent}  acc = acc - $i";
+            push @lines, "${indent}end if";
+        } elsif ($kind == 2) {
+            push @lines, "${indent}select case (mod(acc, 3))";
+            push @lines, "${indent}case (0)";
+            push @lines, "${indent}  acc = acc + 1";
+            push @lines, "${indent}case default";
+            push @lines, "${indent}  acc = acc + 2";
+            push @lines, "${indent}end select";
+        } elsif ($kind == 3 && $routine > 0) {
+            push @lines, "${indent}acc = acc + f" . ($routine - 1) . "(acc, n - 1)";
+        } else {
+            push @lines, "${indent}acc = acc * 3 + $i";
+        }
+    }
+    return @lines;
+}
+
+sub fortran {
+    push @out, "module bench";
+    push @out, "  implicit none";
+    for (my $i = 0; $i < $opt{enums}; $i++) {
+        push @out, comment("  ", "enumeration $i");
+        push @out, map { "  integer, parameter :: color${i}_$_ = $_" } 0 .. 7;
+    }
+    for (my $i = 0; $i < $opt{classes}; $i++) {
+        push @out, comment("  ", "derived type $i");
+        push @out, "  type record$i";
+        push @out, "    integer :: field$i";
+        push @out, "    real :: weight";
+        push @out, "  end type record$i";
+    }
+    push @out, "contains";
+    for (my $r = 0; $r < $opt{routines}; $r++) {
+        push @out, comment("  ", "routine $r");
+        push @out, "  recursive integer function f$r(acc0, n) result(acc)";
+        push @out, "    integer, intent(in) :: acc0, n";
+        push @out, "    integer :: " . join(", ", map { "i$_" } 1 .. ($opt{depth} || 1));
+        push @out, "    acc = acc0";
+        push @out, "    if (n <= 0) return";
+        push @out, fBlock("    ", $opt{depth}, $opt{statements}, $r);
+        push @out, "  end function f$r";
+    }
+    push @out, "end module bench";
+    push @out, "";
+    push @out, "program main";
+    push @out, "  use bench";
+    push @out, "  print *, f" . ($opt{routines} - 1) . "(0, 3)" if $opt{routines} > 0;
+    push @out, "end program main";
+}
+
+if ($lang eq 'fortran') {
+    fortran();
+} else {
+    cLike();
+}
+
+my $fh;
+if ($opt{output} eq '-') {
+    $fh = \*STDOUT;
+} else {
+    open($fh, '>', $opt{output}) or die "Unable to write $opt{output}: $!\n";
+}
+print $fh join("\n", @out), "\n";
+close($fh) unless $opt{output} eq '-';
@@ -0,0 +1,100 @@
+#!/bin/sh
+
+# Runs edg44-pdt_roseparse over synthetic inputs of increasing size (see
+# gencorpus.pl) and records the time and peak memory of each run, to find
+# phases that grow faster than the input.
+#
+# Usage: run_bench.sh [roseparse binary] [output directory]
+#
+# BENCH_LANGS selects the languages (default "c cxx fortran upc") and
+# BENCH_SCALES the size multipliers (default "1 2 4 8 16"). Extra
+# gencorpus.pl options can be given in BENCH_CORPUS_OPTS, for example
+# "--statements=100 --depth=5".
+#
+# Results go to <output directory>/results.tsv, one line per run: language,
+# scale, input lines, total seconds, traversal seconds and peak RSS in kB.
+# A run whose time grows more than 1.5 times faster than its input size
+# relative to the smallest run of the same language is marked SUPERLINEAR.
+
+ROSEPARSE=${1:-./edg44-pdt_roseparse}
+OUTDIR=${2:-bench-results}
+BENCH_LANGS=${BENCH_LANGS:-"c cxx fortran upc"}
+BENCH_SCALES=${BENCH_SCALES:-"1 2 4 8 16"}
+
+BENCH_DIR=`dirname "$0"`
+CONF_DIR=`cd "$BENCH_DIR/.." && pwd`
+
+if [ ! -x "$ROSEPARSE" ]; then
+    echo "Error: $ROSEPARSE not found; build it first." >&2
+    exit 1
+fi
+
+mkdir -p "$OUTDIR" || exit 1
+RESULTS="$OUTDIR/results.tsv"
+printf "# lang\tscale\tlines\tseconds\ttraverse\tpeak_rss_kb\n" > "$RESULTS"
+
+# Prints "total_seconds traverse_seconds max_peak_rss_kb" from a -pdtStats report.
+stats_summary() {
+    perl -e '
+        local $/; my $json = <>;
+        my ($total) = $json =~ /"total_seconds":\s*([0-9.]+)/;
+        my ($traverse) = $json =~ /"phases":\s*\{[^}]*"traverse":\s*([0-9.]+)/;
+        my ($rss) = $json =~ /"peak_rss_kb":\s*\{([^}]*)\}/;
+        my $peak = 0;
+        foreach my $kb (($rss || "") =~ /:\s*(-?\d+)/g) { $peak = $kb if $kb > $peak; }
+        printf "%s %s %d\n", $total || 0, $traverse || 0, $peak;
+    ' "$1"
+}
+
+failures=0
+for lang in $BENCH_LANGS; do
+    case $lang in
+        c) ext=c ;;
+        cxx) ext=cpp ;;
+        fortran) ext=f90 ;;
+        upc) ext=upc ;;
+        *) echo "Unknown language $lang" >&2; exit 1 ;;
+    esac
+
+    baseLines=
+    baseSeconds=
+    for scale in $BENCH_SCALES; do
+        src="$OUTDIR/bench_${lang}_$scale.$ext"
+        pdb="$OUTDIR/bench_${lang}_$scale.pdb"
+        json="$OUTDIR/bench_${lang}_$scale.stats.json"
+
+        perl "$BENCH_DIR/gencorpus.pl" --lang=$lang --scale=$scale $BENCH_CORPUS_OPTS -o "$src" || exit 1
+        lines=`wc -l < "$src" | tr -d ' '`
+
+        rm -f "$json"
+        if ! "$ROSEPARSE" -pdtConfDir="$CONF_DIR" -pdtStats="$json" -o "$pdb" "$src" > "$OUTDIR/bench_${lang}_$scale.log" 2>&1 \
+           || [ ! -f "$json" ]; then
+            echo "FAILED  $lang scale $scale (see $OUTDIR/bench_${lang}_$scale.log)"
+            failures=`expr $failures + 1`
+            continue
+        fi
+
+        set -- `stats_summary "$json"`
+        seconds=$1
+        traverse=$2
+        rss=$3
+
+        note=
+        if [ -z "$baseLines" ]; then
+            baseLines=$lines
+            baseSeconds=$seconds
+        else
+            note=`perl -e '
+                my ($l0, $t0, $l, $t) = @ARGV;
+                print "SUPERLINEAR" if $t0 > 0 && ($t / $t0) > 1.5 * ($l / $l0);
+            ' $baseLines $baseSeconds $lines $seconds`
+        fi
+
+        printf "%s\t%s\t%s\t%s\t%s\t%s\n" $lang $scale $lines $seconds $traverse $rss >> "$RESULTS"
+        printf "%-8s scale %-4s %8s lines %10.3fs (traverse %.3fs) %10s kB %s\n" \
+               $lang $scale $lines $seconds $traverse $rss "$note"
+    done
+done
+
+echo "Results written to $RESULTS"
+[ $failures -eq 0 ]
@@ -0,0 +1,74 @@
+/* Regression input: C routines, structs, enums, macros and pragmas. */
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SQUARE(x) ((x) * (x))
+#define LIMIT 16
+
+enum shape { CIRCLE, SQUARE_SHAPE, TRIANGLE };
+
+struct point {
+    int x;
+    int y;
+};
+
+struct node {
+    struct point where;
+    enum shape kind;
+    struct node *next;
+};
+
+typedef struct node node_t;
+
+static int counter = 0;
+
+/* Appends a node to the front of the list. */
+node_t *push(node_t *head, int x, int y, enum shape kind) {
+    node_t *n = (node_t *) malloc(sizeof(node_t));
+    n->where.x = x;
+    n->where.y = y;
+    n->kind = kind;
+    n->next = head;
+    counter++;
+    return n;
+}
+
+int area(const node_t *n) {
+    switch (n->kind) {
+    case CIRCLE:
+        return 3 * SQUARE(n->where.x);
+    case SQUARE_SHAPE:
+        return SQUARE(n->where.x);
+    default:
+        return n->where.x * n->where.y / 2;
+    }
+}
+
+int total(const node_t *head) {
+    int sum = 0;
+    const node_t *n;
+    for (n = head; n != NULL; n = n->next) {
+        if (area(n) > LIMIT) {
+            sum += LIMIT;
+        } else {
+            sum += area(n);
+        }
+    }
+    return sum;
+}
+
+int main(int argc, char **argv) {
+    node_t *head = NULL;
+    int i;
+#pragma omp parallel for
+    for (i = 0; i < argc; i++) {
+        head = push(head, i, i + 1, (enum shape) (i % 3));
+    }
+    while (head != NULL && total(head) > 100) {
+        node_t *next = head->next;
+        free(head);
+        head = next;
+    }
+    printf("%d %d\n", total(head), counter);
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Regression input: C++ class hierarchies, namespaces, overloads and
+// virtual calls.
+#include <string>
+#include <vector>
+
+namespace geometry {
+
+class Shape {
+public:
+    Shape(const std::string & n) : name(n) {}
+    virtual ~Shape() {}
+    virtual double area() const = 0;
+    const std::string & getName() const { return name; }
+    static int count;
+protected:
+    std::string name;
+};
+
+int Shape::count = 0;
+
+class Circle : public Shape {
+public:
+    explicit Circle(double r) : Shape("circle"), radius(r) { ++count; }
+    double area() const { return 3.14159 * radius * radius; }
+private:
+    double radius;
+};
+
+class Rectangle : public Shape {
+public:
+    Rectangle(double w, double h) : Shape("rectangle"), width(w), height(h) { ++count; }
+    double area() const { return width * height; }
+    Rectangle & operator*=(double f) { width *= f; height *= f; return *this; }
+private:
+    double width;
+    double height;
+};
+
+struct Square : public Rectangle {
+    Square(double s) : Rectangle(s, s) {}
+};
+
+namespace util {
+    double sum(const std::vector<Shape *> & shapes) {
+        double total = 0;
+        for (std::vector<Shape *>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
+            total += (*it)->area();
+        }
+        return total;
+    }
+
+    int scale(int x) { return x * 2; }
+    double scale(double x) { return x * 2.0; }
+}
+
+}
+
+using namespace geometry;
+
+int main() {
+    std::vector<Shape *> shapes;
+    shapes.push_back(new Circle(1.0));
+    Rectangle * r = new Rectangle(2.0, 3.0);
+    *r *= util::scale(1.5);
+    shapes.push_back(r);
+    shapes.push_back(new Square(util::scale(2)));
+    double total = util::sum(shapes);
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        delete shapes[i];
+    }
+    try {
+        if (total < 0) {
+            throw total;
+        }
+    } catch (double d) {
+        return 1;
+    }
+    return Shape::count;
+}
@@ -0,0 +1,67 @@
+// Regression input: class and function templates, specializations,
+// instantiations and nested types.
+#include <cstddef>
+
+namespace containers {
+
+template <typename T, std::size_t N>
+class FixedStack {
+public:
+    typedef T value_type;
+    enum { capacity = N };
+
+    FixedStack() : top(0) {}
+    bool push(const T & v) {
+        if (top == N) {
+            return false;
+        }
+        data[top++] = v;
+        return true;
+    }
+    T pop() { return data[--top]; }
+    std::size_t size() const { return top; }
+
+    struct Iterator {
+        const FixedStack * stack;
+        std::size_t pos;
+        const T & operator*() const { return stack->data[pos]; }
+    };
+
+private:
+    T data[N];
+    std::size_t top;
+};
+
+template <typename T>
+T maximum(T a, T b) {
+    return a > b ? a : b;
+}
+
+template <>
+const char * maximum<const char *>(const char * a, const char * b) {
+    return a;
+}
+
+template <typename T>
+struct Traits {
+    static const bool isPointer = false;
+};
+
+template <typename T>
+struct Traits<T *> {
+    static const bool isPointer = true;
+};
+
+}
+
+template class containers::FixedStack<int, 8>;
+template double containers::maximum<double>(double, double);
+
+int main() {
+    containers::FixedStack<long, 4> s;
+    s.push(containers::maximum(3L, 4L));
+    containers::FixedStack<double, 2> d;
+    d.push(containers::maximum<double>(1.0, 2.0));
+    bool p = containers::Traits<int *>::isPointer && !containers::Traits<int>::isPointer;
+    return static_cast<int>(s.pop() + d.size()) + (p ? 0 : 1);
+}
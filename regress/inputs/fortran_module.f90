@@ -0,0 +1,75 @@
+! Regression input: Fortran modules, derived types, interfaces and
+! internal procedures.
+module shapes
+  implicit none
+
+  integer, parameter :: circle_kind = 1
+  integer, parameter :: square_kind = 2
+
+  type point
+    real :: x
+    real :: y
+  end type point
+
+  type shape
+    integer :: kind
+    type(point) :: centre
+    real :: size
+  end type shape
+
+  interface area
+    module procedure shape_area
+    module procedure point_area
+  end interface area
+
+contains
+
+  real function shape_area(s)
+    type(shape), intent(in) :: s
+    select case (s%kind)
+    case (circle_kind)
+      shape_area = 3.14159 * s%size * s%size
+    case default
+      shape_area = s%size * s%size
+    end select
+  end function shape_area
+
+  real function point_area(p)
+    type(point), intent(in) :: p
+    point_area = 0.0
+  end function point_area
+
+  subroutine grow(s, factor)
+    type(shape), intent(inout) :: s
+    real, intent(in) :: factor
+    s%size = scaled(s%size)
+  contains
+    real function scaled(v)
+      real, intent(in) :: v
+      scaled = v * factor
+    end function scaled
+  end subroutine grow
+
+end module shapes
+
+program main
+  use shapes
+  implicit none
+  type(shape) :: s(4)
+  integer :: i
+  real :: total
+
+  total = 0.0
+  do i = 1, 4
+    s(i)%kind = mod(i, 2) + 1
+    s(i)%centre = point(real(i), 0.0)
+    s(i)%size = real(i)
+    call grow(s(i), 2.0)
+    if (area(s(i)) > 10.0) then
+      total = total + 10.0
+    else
+      total = total + area(s(i))
+    end if
+  end do
+  print *, total
+end program main
@@ -0,0 +1,221 @@
+#!/usr/bin/perl
+
+# Output and performance regression test for edg44-pdt_roseparse.
+#
+# Usage: run_regress.pl [--bless] [--threshold=F] [roseparse binary] [work directory]
+#
+# Parses every file in regress/inputs and compares the PDB with the golden
+# file of the same name in regress/golden. Absolute paths of the inputs and
+# of the roseparse directory are replaced by @INPUTS@ and @ROSEPARSE_DIR@
+# before the comparison, and the system include directories (those listed in
+# rose_c_includes and rose_cxx_includes, and those the host's cc and c++
+# search) by @SYSINC@; otherwise the output must match byte for byte.
+# --bless writes the current output as the new goldens instead of comparing;
+# run it with a binary built from a known-good revision.
+#
+# The wall time, traversal time (from -pdtStats) and peak RSS of every
+# input are appended to <work directory>/history.tsv (or $REGRESS_HISTORY).
+# A metric regresses if it exceeds the best of the last five recorded runs
+# of that input by more than the threshold (default 0.25, i.e. 25%). Time
+# differences below 0.05 seconds are ignored as noise.
+#
+# Exits nonzero if any PDB differs, any parse fails or any metric regresses.
+
+use strict;
+use warnings;
+use Cwd qw(abs_path);
+use File::Basename qw(dirname);
+use File::Path qw(mkpath);
+use Getopt::Long;
+use POSIX qw(strftime);
+use Time::HiRes qw(time);
+
+my $bless = 0;
+my $threshold = 0.25;
+my $window = 5;
+my $minSeconds = 0.05;
+
+GetOptions('bless' => \$bless, 'threshold=f' => \$threshold)
+    or die "Usage: $0 [--bless] [--threshold=F] [roseparse binary] [work directory]\n";
+
+my $roseparse = abs_path($ARGV[0] || './edg44-pdt_roseparse');
+my $workDir = $ARGV[1] || 'regress-results';
+
+my $regressDir = abs_path(dirname($0));
+my $inputDir = "$regressDir/inputs";
+my $goldenDir = "$regressDir/golden";
+my $confDir = dirname($regressDir);
+
+die "Error: $ARGV[0] not found; build it first.\n" unless defined $roseparse && -x $roseparse;
+
+if (!$bless && !-d $goldenDir) {
+    die "Error: $goldenDir doesn't exist. Bless the goldens with a known-good build first:\n"
+      . "  perl $0 --bless <roseparse binary> <work directory>\n";
+}
+
+mkpath($workDir) unless -d $workDir;
+mkpath($goldenDir) if $bless && !-d $goldenDir;
+$workDir = abs_path($workDir);
+my $historyFile = $ENV{REGRESS_HISTORY} || "$workDir/history.tsv";
+
+my @systemIncludeDirs = systemIncludeDirs();
+
+opendir(my $dh, $inputDir) or die "Unable to read $inputDir: $!\n";
+my @inputs = sort grep { /\.(c|cpp|cc|cxx|C|upc|f|f90|F90)$/ } readdir($dh);
+closedir($dh);
+
+# History lines: date, revision, input, wall seconds, traverse seconds, peak RSS kB.
+my %history;
+if (open(my $hf, '<', $historyFile)) {
+    while (my $line = <$hf>) {
+        next if $line =~ /^#/;
+        chomp $line;
+        my @f = split /\t/, $line;
+        push @{$history{$f[2]}}, [@f[3 .. 5]] if @f >= 6;
+    }
+    close($hf);
+}
+
+my $revision = `git -C "$confDir" rev-parse --short HEAD 2>/dev/null`;
+chomp $revision;
+$revision = 'unknown' if $revision eq '';
+my $date = strftime('%Y-%m-%dT%H:%M:%S', localtime);
+
+my $newHistory = !-e $historyFile;
+open(my $history, '>>', $historyFile) or die "Unable to write $historyFile: $!\n";
+print $history "# date\trevision\tinput\twall_seconds\ttraverse_seconds\tpeak_rss_kb\n" if $newHistory;
+
+my $failures = 0;
+foreach my $input (@inputs) {
+    my $pdb = "$workDir/$input.pdb";
+    my $json = "$workDir/$input.stats.json";
+    my $log = "$workDir/$input.log";
+    unlink($pdb, $json);
+
+    my $start = time;
+    my $status = system("\"$roseparse\" -pdtConfDir=\"$confDir\" -pdtStats=\"$json\" -o \"$pdb\" \"$inputDir/$input\" > \"$log\" 2>&1");
+    my $wall = time - $start;
+    if ($status != 0 || !-f $pdb || !-f $json) {
+        print "FAILED    $input (see $log)\n";
+        $failures++;
+        next;
+    }
+
+    my $output = normalize(readFile($pdb));
+    my $result;
+    if ($bless) {
+        writeFile("$goldenDir/$input.pdb", $output);
+        $result = 'BLESSED';
+    } elsif (!-f "$goldenDir/$input.pdb") {
+        $result = 'NO GOLDEN';
+        $failures++;
+    } elsif ($output ne readFile("$goldenDir/$input.pdb")) {
+        writeFile("$workDir/$input.normalized.pdb", $output);
+        $result = 'DIFFERS';
+        $failures++;
+    } else {
+        $result = 'ok';
+    }
+
+    my $stats = readFile($json);
+    my ($traverse) = $stats =~ /"phases":\s*\{[^}]*"traverse":\s*([0-9.]+)/;
+    my ($rssList) = $stats =~ /"peak_rss_kb":\s*\{([^}]*)\}/;
+    my $rss = 0;
+    foreach my $kb (($rssList || '') =~ /:\s*(-?\d+)/g) {
+        $rss = $kb if $kb > $rss;
+    }
+    my @current = (sprintf('%.6f', $wall), $traverse || 0, $rss);
+
+    my @regressions;
+    my @previous = @{$history{$input} || []};
+    @previous = @previous[-$window .. -1] if @previous > $window;
+    if (@previous) {
+        my @names = ('wall', 'traverse', 'rss');
+        for (my $i = 0; $i < 3; $i++) {
+            my $best = $previous[0][$i];
+            foreach my $p (@previous) {
+                $best = $p->[$i] if $p->[$i] < $best;
+            }
+            next if $i < 2 && $current[$i] - $best < $minSeconds;
+            if ($current[$i] > $best * (1 + $threshold)) {
+                push @regressions, "$names[$i] $best -> $current[$i]";
+            }
+        }
+    }
+    printf "%-9s %-24s %8.3fs (traverse %.3fs) %10d kB\n", $result, $input, @current;
+    print "  diff $goldenDir/$input.pdb $workDir/$input.normalized.pdb\n" if $result eq 'DIFFERS';
+    if (@regressions) {
+        print "  SLOWER: ", join(", ", @regressions), "\n";
+        $failures++;
+    }
+
+    # Only runs with the expected output set the baseline.
+    if ($result eq 'ok' || $result eq 'BLESSED') {
+        print $history join("\t", $date, $revision, $input, @current), "\n";
+    }
+}
+close($history);
+
+print "$failures failure(s)\n" if $failures;
+exit($failures ? 1 : 0);
+
+sub readFile {
+    my ($name) = @_;
+    open(my $fh, '<', $name) or die "Unable to read $name: $!\n";
+    local $/;
+    my $text = <$fh>;
+    close($fh);
+    return $text;
+}
+
+sub writeFile {
+    my ($name, $text) = @_;
+    open(my $fh, '>', $name) or die "Unable to write $name: $!\n";
+    print $fh $text;
+    close($fh);
+}
+
+# Absolute include directories outside the roseparse directory, longest
+# first so that nested directories are replaced before their parents.
+sub systemIncludeDirs {
+    my %dirs;
+    foreach my $config ("$confDir/rose_c_includes", "$confDir/rose_cxx_includes") {
+        open(my $fh, '<', $config) or next;
+        while (my $line = <$fh>) {
+            chomp $line;
+            $dirs{$line} = 1 if $line =~ m{^/};
+        }
+        close($fh);
+    }
+    foreach my $compiler ('cc -x c', 'c++ -x c++') {
+        my $inSearchList = 0;
+        foreach my $line (`$compiler -E -v /dev/null 2>&1 >/dev/null`) {
+            if ($line =~ /^#include <\.\.\.> search starts here:/) {
+                $inSearchList = 1;
+            } elsif ($line =~ /^End of search list\./) {
+                $inSearchList = 0;
+            } elsif ($inSearchList && $line =~ m{^\s+(/\S+)}) {
+                $dirs{$1} = 1;
+            }
+        }
+    }
+    my @result;
+    foreach my $dir (keys %dirs) {
+        $dir =~ s{/+$}{};
+        next if $dir eq '' || index($dir, $confDir) == 0;
+        push @result, $dir;
+        my $real = abs_path($dir);
+        push @result, $real if defined $real && $real ne $dir && index($real, $confDir) != 0;
+    }
+    return sort { length($b) <=> length($a) || $a cmp $b } @result;
+}
+
+sub normalize {
+    my ($text) = @_;
+    $text =~ s/\Q$inputDir\E/\@INPUTS\@/g;
+    $text =~ s/\Q$confDir\E/\@ROSEPARSE_DIR\@/g;
+    foreach my $dir (@systemIncludeDirs) {
+        $text =~ s{\Q$dir\E/}{\@SYSINC\@/}g;
+    }
+    return $text;
+}
@@ -70,7 +70,7 @@
 
 class Group;
 
-class BaseGroup {
+class BaseGroup : public PooledEntity<MEM_BASE_GROUP, BaseGroup> {
     public:
         bool virt;
         bool pub;
@@ -78,31 +78,31 @@ class BaseGroup {
         bool priv;
         int id;
         SgClassDeclaration * sgClass;
-        SourceLocation * loc;
-        std::string name;
+        SourceLocation loc;
+        InternedString name;
 
-        BaseGroup(int i = -1, SourceLocation * l = NULL, bool vrt = false, bool b = false,
+        BaseGroup(int i = -1, const SourceLocation & l = SourceLocation(), bool vrt = false, bool b = false,
                   bool t = false, bool v = false, std::string n = "") : virt(vrt), pub(b), prot(t), priv(v),
                                                                         id(i), sgClass(NULL), loc(l),
                                                                         name(n) {};
 
 };
 
-class MemberFunction {
+class MemberFunction : public PooledEntity<MEM_MEMBER_FUNCTION, MemberFunction> {
     public:
         int id;
         SgFunctionDeclaration * sgFunction;
-        std::string name;
-        SourceLocation * loc;
+        InternedString name;
+        SourceLocation loc;
 
-        MemberFunction(int i = -1, SourceLocation * l = NULL, std::string n = "") : id(i), sgFunction(NULL),
+        MemberFunction(int i = -1, const SourceLocation & l = SourceLocation(), std::string n = "") : id(i), sgFunction(NULL),
                                                                                       name(n), loc(l) {};
 };
 
-class Member {
+class Member : public PooledEntity<MEM_MEMBER, Member> {
     public:
-        std::string name;
-        SourceLocation * gmloc;
+        InternedString name;
+        SourceLocation gmloc;
         
         enum MemberAccess {
             GMACS_NA, GMACS_PUB, GMACS_PROT, GMACS_PRIV
@@ -126,17 +126,17 @@ class Member {
 
         int gmtempl;
 
-        Member(std::string n, SourceLocation * loc) : name(n), gmloc(loc), gmacs(GMACS_NA),
+        Member(std::string n, const SourceLocation & loc) : name(n), gmloc(loc), gmacs(GMACS_NA),
                                                       gmkind(GMKIND_NA), gmtype_group(false), 
                                                       gmtype(-1), gmconst(false), gmisbit(false),
                                                       gmmut(false), gmtempl(-1) {};
 };
 
-class Group {
+class Group : public PooledEntity<MEM_GROUP, Group> {
 public:
 	int id;
-	std::string name;
-	SourceLocation * gloc;
+	InternedString name;
+	SourceLocation gloc;
 
     int ggroup; // parent group
     int gnspace;
@@ -163,15 +163,15 @@ public:
     std::vector<MemberFunction *> gfuncs;
     std::vector<Member *> gmems;
 
-    SourceLocation * gpos_groupToken;
-    SourceLocation * gpos_tokenEnd;
-    SourceLocation * gpos_blockStart;
-    SourceLocation * gpos_blockEnd;
+    SourceLocation gpos_groupToken;
+    SourceLocation gpos_tokenEnd;
+    SourceLocation gpos_blockStart;
+    SourceLocation gpos_blockEnd;
     
-    Group(int i, std::string n, SourceLocation * l = NULL) : id(i), name(n), gloc(l), ggroup(-1), gnspace(-1), 
-                                                             gacs(ACS_NA), gkind(GKIND_NA), gtempl(-1), gpos_groupToken(NULL),
-                                                             gpos_tokenEnd(NULL), gpos_blockStart(NULL),
-                                                             gpos_blockEnd(NULL) {};
+    Group(int i, std::string n, const SourceLocation & l = SourceLocation()) : id(i), name(n), gloc(l), ggroup(-1), gnspace(-1), 
+                                                             gacs(ACS_NA), gkind(GKIND_NA), gtempl(-1), gpos_groupToken(),
+                                                             gpos_tokenEnd(), gpos_blockStart(),
+                                                             gpos_blockEnd() {};
 
     friend std::ostream & operator<<(std::ostream & out, const Group & r);
             
@@ -180,8 +180,8 @@ public:
 
         s << "gr#" << id << " " << name << "\n";
 
-        if(gloc != NULL) {
-            s << "gloc " << (*gloc) << "\n";
+        if(gloc.isValid()) {
+            s << "gloc " << gloc << "\n";
         }    
 
         if(ggroup > 0 && gnspace <= 0) {
@@ -234,8 +234,8 @@ public:
 
            s << "gr#" << base->id << " ";
 
-           if(base->loc != NULL) {
-               s << *(base->loc);
+           if(base->loc.isValid()) {
+               s << base->loc;
            } else {
                s << "NULL 0 0";
            }
@@ -246,8 +246,8 @@ public:
         for(std::vector<BaseGroup *>::const_iterator it = gfrgroups.begin(); it != gfrgroups.end(); ++it) {
             BaseGroup * base = *it;
             s << "gfrgroup gr#" << base->id << " ";
-            if(base->loc != NULL) {
-                s << *(base->loc);
+            if(base->loc.isValid()) {
+                s << base->loc;
             } else {
                 s << "NULL 0 0";
             }
@@ -257,8 +257,8 @@ public:
         for(std::vector<MemberFunction *>::const_iterator it = gfrfuncs.begin(); it != gfrfuncs.end(); ++it) {
             MemberFunction * func = *it;
             s << "gfrfunc ro#" << func->id << " ";
-            if(func->loc != NULL) {
-                s << *(func->loc);
+            if(func->loc.isValid()) {
+                s << func->loc;
             } else {
                 s << "NULL 0 0";
             }
@@ -268,8 +268,8 @@ public:
         for(std::vector<MemberFunction *>::const_iterator it = gfuncs.begin(); it != gfuncs.end(); ++it) {
             MemberFunction * func = *it;
             s << "gfunc ro#" << func->id << " ";
-            if(func->loc != NULL) {
-                s << *(func->loc);
+            if(func->loc.isValid()) {
+                s << func->loc;
             } else {
                 s << "NULL 0 0";
             }
@@ -279,8 +279,8 @@ public:
         for(std::vector<Member *>::const_iterator it = gmems.begin(); it != gmems.end(); ++it) {
             Member * m = *it;
             s << "gmem " << m->name << std::endl;
-            if(m->gmloc != NULL) {
-                s << "gmloc " << *(m->gmloc) << "\n";
+            if(m->gmloc.isValid()) {
+                s << "gmloc " << m->gmloc << "\n";
             } else {
                 s << "NULL 0 0\n";
             }
@@ -325,26 +325,26 @@ public:
         }
         s << "gpos ";
           
-        if(gpos_groupToken != NULL) {
-            s << *(gpos_groupToken) << " ";
+        if(gpos_groupToken.isValid()) {
+            s << gpos_groupToken << " ";
         } else {
             s << "NULL 0 0";
         }
 
-        if(gpos_tokenEnd != NULL) {
-            s << *(gpos_tokenEnd) << " ";
+        if(gpos_tokenEnd.isValid()) {
+            s << gpos_tokenEnd << " ";
         } else {
             s << " NULL 0 0";
         }
         
-        if(gpos_blockStart != NULL) {
-            s << *(gpos_blockStart) << " ";
+        if(gpos_blockStart.isValid()) {
+            s << gpos_blockStart << " ";
         } else {
             s << " NULL 0 0";
         }
 
-        if(gpos_blockEnd != NULL) {
-            s << *(gpos_blockEnd);
+        if(gpos_blockEnd.isValid()) {
+            s << gpos_blockEnd;
         } else {
             s << " NULL 0 0";
         }
@@ -0,0 +1,120 @@
+#ifndef __INTERN_H__
+#define __INTERN_H__
+
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <boost/unordered_set.hpp>
+
+#include "ptrmap.h"
+
+// Pool of the names, mangled names and paths of the entities in one
+// translation unit. Each distinct string is stored once; InternedString
+// handles point at the stored copy, so equal strings have equal handles
+// and maps can be keyed by the handle instead of the string. The pool is
+// emptied by resetGlobalState(), which invalidates all handles.
+class StringPool {
+public:
+    const std::string * intern(const std::string & s) {
+        if(s.empty()) {
+            return &emptyString();
+        }
+        return &*strings.insert(s).first;
+    }
+
+    size_t size(void) const {
+        return strings.size();
+    }
+
+    // Characters stored, not counting the strings' own overhead.
+    size_t characters(void) const {
+        size_t n = 0;
+        for(boost::unordered_set<std::string>::const_iterator it = strings.begin(); it != strings.end(); ++it) {
+            n += it->size();
+        }
+        return n;
+    }
+
+    void clear(void) {
+        strings.clear();
+    }
+
+    static const std::string & emptyString(void) {
+        static const std::string empty;
+        return empty;
+    }
+
+private:
+    // Elements of an unordered_set don't move when it rehashes.
+    boost::unordered_set<std::string> strings;
+};
+
+StringPool stringPool;
+
+class InternedString {
+public:
+    InternedString() : s(&StringPool::emptyString()) {};
+    InternedString(const std::string & str) : s(stringPool.intern(str)) {};
+    InternedString(const char * str) : s(stringPool.intern(str)) {};
+
+    const std::string & str(void) const {
+        return *s;
+    }
+
+    operator const std::string &() const {
+        return *s;
+    }
+
+    // The same pointer for every handle to an equal string.
+    const std::string * get(void) const {
+        return s;
+    }
+
+    bool empty(void) const {
+        return s->empty();
+    }
+
+private:
+    const std::string * s;
+};
+
+inline std::ostream & operator<<(std::ostream & out, const InternedString & s) {
+    return out << s.str();
+}
+
+// Map keyed by interned string, with the parts of the std::map interface
+// the entity tables use. Looking up a std::string interns it.
+template<typename V>
+class InternMap {
+public:
+    size_t count(const InternedString & key) const {
+        return map.find(key.get()) != NULL ? 1 : 0;
+    }
+
+    // Returns the value stored for key, or NULL if there is none. Unlike
+    // operator[], doesn't add an entry for a missing key.
+    const V * find(const InternedString & key) const {
+        return map.find(key.get());
+    }
+
+    V & operator[](const InternedString & key) {
+        return map[key.get()];
+    }
+
+    // Stores value unless key is already present, like std::map::insert.
+    void insert(const std::pair<InternedString, V> & entry) {
+        if(map.find(entry.first.get()) == NULL) {
+            map.insert(entry.first.get(), entry.second);
+        }
+    }
+
+    void clear(void) {
+        map.clear();
+    }
+
+private:
+    PtrMap<std::string, V> map;
+};
+
+#endif
@@ -18,16 +18,16 @@
 #include "rose.h"
 #include "pdtutil.h"
 
-class Macro {
+class Macro : public PooledEntity<MEM_MACRO, Macro> {
 public:
 	int id;
-	SourceLocation * mloc;
+	SourceLocation mloc;
 	bool mkind; // false = def, true = undef
 	std::string mtext;
 	
-	Macro(int i = -1, SourceLocation * l = NULL, bool k = false, 
+	Macro(int i = -1, const SourceLocation & l = SourceLocation(), bool k = false, 
 		  std::string t = "") : id(i), mloc(l), mkind(k), mtext(t) {};
-	// Macro(int i = -1, SourceLocation * l = NULL, bool k = false, 
+	// Macro(int i = -1, const SourceLocation & l = SourceLocation(), bool k = false, 
 	// 	  const std::string & t = "") : id(i), mloc(l), mkind(k), mtext(t) {};
 	
 
@@ -38,8 +38,8 @@ public:
 		s << "ma#" << id << "\n";
 		
 		s << "mloc ";
-		if(mloc != NULL) {
-			s << (*mloc) << "\n";
+		if(mloc.isValid()) {
+			s << mloc << "\n";
 		} else {
 			s << "NULL 0 0\n";
 		}
@@ -20,7 +20,7 @@
 
 #include "pdtutil.h"
 
-class NamespaceMember {
+class NamespaceMember : public PooledEntity<MEM_NAMESPACE_MEMBER, NamespaceMember> {
 public:
     enum NamespaceMemberKind {
         NS_NA, NS_TYPE, NS_ROUTINE, NS_GROUP, NS_TEMPL, NS_NS
@@ -28,20 +28,20 @@ public:
     
     NamespaceMemberKind kind;
     int id;
-    std::string name;
+    InternedString name;
 
     NamespaceMember(int i = -1, NamespaceMemberKind k = NS_NA) : kind(k), id(i) {};
 };
 
-class Namespace {
+class Namespace : public PooledEntity<MEM_NAMESPACE, Namespace> {
 public:
     int id;
-    std::string name;
-    SourceLocation * nloc;
-    SourceLocation * ns_token;
-    SourceLocation * ns_tokenEnd;
-    SourceLocation * ns_blockStart;
-    SourceLocation * ns_blockEnd;
+    InternedString name;
+    SourceLocation nloc;
+    SourceLocation ns_token;
+    SourceLocation ns_tokenEnd;
+    SourceLocation ns_blockStart;
+    SourceLocation ns_blockEnd;
     int nnspace; // parent namespace
     std::vector<NamespaceMember*> nmems; // namespace members
     int nalias; // this namespace is an alias of nalias
@@ -49,8 +49,8 @@ public:
     SgNamespaceDeclarationStatement * nsSgStmt;
 	SgNamespaceAliasDeclarationStatement * nsAliasSgStmt;
 
-    Namespace(int i, std::string n) : id(i), name(n), nloc(NULL), ns_token(NULL), ns_tokenEnd(NULL), 
-                                      ns_blockStart(NULL), ns_blockEnd(NULL), nnspace(-1), nalias(-1),
+    Namespace(int i, std::string n) : id(i), name(n), nloc(), ns_token(), ns_tokenEnd(), 
+                                      ns_blockStart(), ns_blockEnd(), nnspace(-1), nalias(-1),
                                       nsSgStmt(NULL), nsAliasSgStmt(NULL) {};
 
     friend std::ostream & operator<<(std::ostream & out, const Namespace & r);
@@ -61,8 +61,8 @@ public:
         s << "na#" << id << " " << name << "\n";
         
         s << "nloc ";
-        if(nloc != NULL) {
-            s << *(nloc) << "\n";
+        if(nloc.isValid()) {
+            s << nloc << "\n";
         } else {
             s << "NULL 0 0\n";
         }
@@ -89,26 +89,26 @@ public:
         }
 
         s << "npos ";
-        if(ns_token != NULL) {
-            s << *(ns_token) << " ";
+        if(ns_token.isValid()) {
+            s << ns_token << " ";
         } else { 
             s << "NULL 0 0 ";
         }
 
-        if(ns_tokenEnd != NULL ) {
-            s << *(ns_tokenEnd) << " ";
+        if(ns_tokenEnd.isValid() ) {
+            s << ns_tokenEnd << " ";
         } else {
             s << "NULL 0 0 ";
         }
 
-        if(ns_blockStart != NULL) {
-            s << *(ns_blockStart) << " ";
+        if(ns_blockStart.isValid()) {
+            s << ns_blockStart << " ";
         } else {
             s << "NULL 0 0 ";
         }
 
-        if(ns_blockEnd != NULL) {
-            s << *(ns_blockEnd);
+        if(ns_blockEnd.isValid()) {
+            s << ns_blockEnd;
         } else {
             s << "NULL 0 0";
         }
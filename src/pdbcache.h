@@ -0,0 +1,392 @@
+#ifndef __PDBCACHE_H__
+#define __PDBCACHE_H__
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "pdtdigest.h"
+
+#ifndef BACKEND_C_COMPILER_NAME_WITH_PATH
+#define BACKEND_C_COMPILER_NAME_WITH_PATH "cc"
+#endif
+#ifndef BACKEND_CXX_COMPILER_NAME_WITH_PATH
+#define BACKEND_CXX_COMPILER_NAME_WITH_PATH "c++"
+#endif
+
+// Content-addressed cache of generated PDB files (-pdtCacheDir=<dir>).
+//
+// The key is the SHA-256 digest of the raw bytes of the source and of every
+// file the backend compiler reports it depends on (cc -M), the compiler's
+// predefined macros, the command line, the working directory, the include
+// configuration files, the PDB format version and the roseparse
+// executable, so a PDB is reused only if nothing that could change it has
+// changed. Only C, C++ and UPC inputs are cached; for anything else the
+// cache is disabled.
+//
+// Entries are stored as <dir>/<xx>/<key>.pdb and are hard linked (or
+// copied, across file systems) to the output file on a hit.
+class PDBCache {
+public:
+    PDBCache(const std::string & d) : dir(d), enabled(!d.empty()) {};
+
+    bool isEnabled(void) const {
+        return enabled;
+    }
+
+    // Computes the key. Disables the cache for this translation unit if the
+    // input can't be preprocessed.
+    void computeKey(const std::vector<std::string> & args, const std::vector<std::string> & configFiles,
+                    const std::string & version) {
+        if(!enabled) {
+            return;
+        }
+        const std::string sources = classifyArguments(args);
+        if(sources.empty() || dependencyCommand.empty()) {
+            enabled = false;
+            return;
+        }
+
+        PDTDigest digest;
+        const std::string build = executableIdentity(args.front());
+        if(!digest.isValid() || build.empty()) {
+            std::cerr << "WARNING: Unable to identify the roseparse build for the PDB cache; not caching." << std::endl;
+            enabled = false;
+            return;
+        }
+        digest.add(version).add(build);
+        char * cwd = getcwd(NULL, 0);
+        if(cwd != NULL) {
+            digest.add(cwd);
+            free(cwd);
+        }
+        for(std::vector<std::string>::const_iterator it = keyArgs.begin(); it != keyArgs.end(); ++it) {
+            digest.add(*it);
+        }
+        for(std::vector<std::string>::const_iterator it = configFiles.begin(); it != configFiles.end(); ++it) {
+            digest.add(*it);
+            addFileContents(*it, digest);
+            digest.add("");
+        }
+
+        std::string predefined;
+        std::string rules;
+        if(!runCommand(predefinedCommand, predefined) || !runCommand(dependencyCommand, rules)) {
+            std::cerr << "WARNING: Unable to preprocess " << sources << " for the PDB cache; not caching." << std::endl;
+            enabled = false;
+            return;
+        }
+        digest.add(predefined);
+
+        const std::vector<std::string> files = parseDependencies(rules);
+        for(std::vector<std::string>::const_iterator it = files.begin(); it != files.end(); ++it) {
+            digest.add(*it);
+            if(!addFileContents(*it, digest)) {
+                std::cerr << "WARNING: Unable to read " << *it << " for the PDB cache; not caching." << std::endl;
+                enabled = false;
+                return;
+            }
+            digest.add("");
+        }
+        key = digest.hexString();
+    }
+
+    // Name of the PDB file the translation unit will be written to.
+    const std::string & getOutputName(void) const {
+        return outputName;
+    }
+
+    // Links or copies a cached PDB to outName. Returns false on a miss.
+    bool fetch(const std::string & outName) const {
+        if(!enabled) {
+            return false;
+        }
+        const std::string path = entryPath();
+        if(access(path.c_str(), R_OK) != 0) {
+            return false;
+        }
+        // Only replace regular files; outName may also be e.g. /dev/null.
+        struct stat st;
+        if(lstat(outName.c_str(), &st) != 0 || S_ISREG(st.st_mode)) {
+            unlink(outName.c_str());
+            if(link(path.c_str(), outName.c_str()) == 0) {
+                return true;
+            }
+        }
+        return copyFile(path, outName);
+    }
+
+    // Removes path if it is a hard link shared with another file (e.g. a
+    // cache entry), so that writing a new PDB doesn't modify the other one.
+    static void detach(const std::string & path) {
+        struct stat st;
+        if(lstat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode) && st.st_nlink > 1) {
+            unlink(path.c_str());
+        }
+    }
+
+    // Adds a freshly written PDB to the cache. The output name isn't part
+    // of the key, so anything but a non-empty regular file (e.g. -o
+    // /dev/null) is left out rather than stored under the input's key.
+    void store(const std::string & outName) const {
+        if(!enabled) {
+            return;
+        }
+        struct stat st;
+        if(lstat(outName.c_str(), &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+            return;
+        }
+        const std::string subdir = dir + "/" + key.substr(0, 2);
+        mkdir(dir.c_str(), 0777);
+        mkdir(subdir.c_str(), 0777);
+
+        // Write under a temporary name first so concurrent readers never
+        // see a partial entry.
+        char pid[32];
+        snprintf(pid, sizeof(pid), ".%ld.tmp", static_cast<long>(getpid()));
+        const std::string tmp = entryPath() + pid;
+        if(!copyFile(outName, tmp) || rename(tmp.c_str(), entryPath().c_str()) != 0) {
+            std::cerr << "WARNING: Unable to add " << outName << " to the PDB cache in " << dir << std::endl;
+            unlink(tmp.c_str());
+        }
+    }
+
+private:
+    std::string dir;
+    bool enabled;
+    std::string key;
+    std::string outputName;
+    std::vector<std::string> keyArgs;
+    std::vector<std::string> dependencyCommand;
+    std::vector<std::string> predefinedCommand;
+
+    const std::string entryPath(void) const {
+        return dir + "/" + key.substr(0, 2) + "/" + key + ".pdb";
+    }
+
+    static std::string extensionOf(const std::string & file) {
+        const std::string::size_type dot = file.rfind('.');
+        const std::string::size_type slash = file.rfind('/');
+        if(dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+            return "";
+        }
+        return file.substr(dot + 1);
+    }
+
+    static std::string baseNameOf(const std::string & file) {
+        const std::string::size_type slash = file.rfind('/');
+        std::string base = slash == std::string::npos ? file : file.substr(slash + 1);
+        const std::string::size_type dot = base.rfind('.');
+        if(dot != std::string::npos) {
+            base = base.substr(0, dot);
+        }
+        return base;
+    }
+
+    // Sorts the command line into the arguments that go into the key and
+    // the preprocessor command lines, and determines the output name.
+    // Returns the source files, or an empty string if the input can't be
+    // cached.
+    std::string classifyArguments(const std::vector<std::string> & args) {
+        std::vector<std::string> cppArgs;
+        std::string sources;
+        bool cxx = false;
+        for(std::vector<std::string>::size_type i = 1; i < args.size(); ++i) {
+            const std::string & arg = args[i];
+            const bool hasNext = i + 1 < args.size();
+            if(arg.compare(0, 13, "-pdtCacheDir=") == 0 || arg.compare(0, 10, "-pdtStats=") == 0
+               || arg.compare(0, 12, "-pdtProfile=") == 0) {
+                continue;
+            }
+            if(arg == "-o" && hasNext) {
+                outputName = args[++i];
+                continue;
+            }
+            keyArgs.push_back(arg);
+            if((arg == "-I" || arg == "-D" || arg == "-U" || arg == "-include") && hasNext) {
+                cppArgs.push_back(arg);
+                cppArgs.push_back(args[++i]);
+                keyArgs.push_back(args[i]);
+            } else if(arg.compare(0, 2, "-I") == 0 || arg.compare(0, 2, "-D") == 0 || arg.compare(0, 2, "-U") == 0) {
+                cppArgs.push_back(arg);
+            } else if(!arg.empty() && arg[0] != '-') {
+                const std::string ext = extensionOf(arg);
+                if(ext == "c" || ext == "upc") {
+                    // Preprocessed as C.
+                } else if(ext == "C" || ext == "cc" || ext == "cpp" || ext == "cxx" || ext == "c++" || ext == "cp" || ext == "CPP") {
+                    cxx = true;
+                } else {
+                    return "";
+                }
+                if(outputName.empty() && sources.empty()) {
+                    outputName = baseNameOf(arg) + ".pdb";
+                }
+                if(ext == "upc") {
+                    cppArgs.push_back("-x");
+                    cppArgs.push_back("c");
+                }
+                cppArgs.push_back(arg);
+                sources += (sources.empty() ? "" : " ") + arg;
+            }
+        }
+        if(sources.empty()) {
+            return "";
+        }
+        if(outputName.empty() || outputName == "a.out") {
+            // Same rule as generatePDBFileName().
+            outputName = baseNameOf(sources.substr(0, sources.find(' '))) + ".pdb";
+        }
+        const char * compiler = cxx ? BACKEND_CXX_COMPILER_NAME_WITH_PATH : BACKEND_C_COMPILER_NAME_WITH_PATH;
+        dependencyCommand.push_back(compiler);
+        dependencyCommand.push_back("-M");
+        dependencyCommand.insert(dependencyCommand.end(), cppArgs.begin(), cppArgs.end());
+        // -D and -U arguments are already part of the key.
+        predefinedCommand.push_back(compiler);
+        predefinedCommand.push_back("-dM");
+        predefinedCommand.push_back("-E");
+        predefinedCommand.push_back("-x");
+        predefinedCommand.push_back(cxx ? "c++" : "c");
+        predefinedCommand.push_back("/dev/null");
+        return sources;
+    }
+
+    // Identifies the roseparse executable by its device, inode, size and
+    // modification time, which change whenever it is relinked, whatever
+    // source file changed. Digesting the (static, very large) binary itself
+    // would cost more than many parses.
+    static std::string executableIdentity(const std::string & argv0) {
+        struct stat st;
+        if(stat("/proc/self/exe", &st) != 0
+           && (argv0.find('/') == std::string::npos || stat(argv0.c_str(), &st) != 0)) {
+            return "";
+        }
+        std::ostringstream identity;
+        identity << st.st_dev << " " << st.st_ino << " " << st.st_size << " " << st.st_mtime;
+        return identity.str();
+    }
+
+    // Files named by the make rules cc -M prints, without the targets. In
+    // the rules, "\ " and "\#" stand for a space and a '#', "$$" for a '$',
+    // and a backslash at the end of a line continues it.
+    static std::vector<std::string> parseDependencies(const std::string & rules) {
+        std::vector<std::string> files;
+        std::string current;
+        bool inTargets = true;
+        for(std::string::size_type i = 0; i < rules.size(); ++i) {
+            const char c = rules[i];
+            const bool hasNext = i + 1 < rules.size();
+            if(c == '\\' && hasNext && rules[i + 1] == '\n') {
+                ++i;
+                if(!current.empty() && !inTargets) {
+                    files.push_back(current);
+                }
+                current.clear();
+            } else if(c == '\\' && hasNext && (rules[i + 1] == ' ' || rules[i + 1] == '#')) {
+                current += rules[++i];
+            } else if(c == '$' && hasNext && rules[i + 1] == '$') {
+                current += rules[++i];
+            } else if(c == ':' && inTargets && (!hasNext || rules[i + 1] == ' ' || rules[i + 1] == '\n')) {
+                inTargets = false;
+                current.clear();
+            } else if(c == ' ' || c == '\t' || c == '\n') {
+                if(!current.empty() && !inTargets) {
+                    files.push_back(current);
+                }
+                current.clear();
+                if(c == '\n') {
+                    inTargets = true;
+                }
+            } else {
+                current += c;
+            }
+        }
+        if(!current.empty() && !inTargets) {
+            files.push_back(current);
+        }
+        return files;
+    }
+
+    // Feeds the raw bytes of a file into digest.
+    static bool addFileContents(const std::string & path, PDTDigest & digest) {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        if(!in.is_open()) {
+            return false;
+        }
+        char buf[65536];
+        while(in.read(buf, sizeof(buf)) || in.gcount() > 0) {
+            digest.add(buf, static_cast<size_t>(in.gcount()));
+        }
+        return !in.bad();
+    }
+
+    // Runs command and collects its standard output.
+    static bool runCommand(const std::vector<std::string> & command, std::string & output) {
+        int fds[2];
+        if(pipe(fds) != 0) {
+            return false;
+        }
+        const pid_t pid = fork();
+        if(pid < 0) {
+            close(fds[0]);
+            close(fds[1]);
+            return false;
+        }
+        if(pid == 0) {
+            dup2(fds[1], STDOUT_FILENO);
+            const int devnull = open("/dev/null", O_WRONLY);
+            if(devnull >= 0) {
+                dup2(devnull, STDERR_FILENO);
+            }
+            close(fds[0]);
+            close(fds[1]);
+            std::vector<char *> argv;
+            for(std::vector<std::string>::const_iterator it = command.begin(); it != command.end(); ++it) {
+                argv.push_back(const_cast<char *>(it->c_str()));
+            }
+            argv.push_back(NULL);
+            execvp(argv[0], &argv[0]);
+            _exit(127);
+        }
+        close(fds[1]);
+        char buf[65536];
+        ssize_t n;
+        while((n = read(fds[0], buf, sizeof(buf))) != 0) {
+            if(n < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            output.append(buf, n);
+        }
+        close(fds[0]);
+        int status = 0;
+        while(waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+        }
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+    static bool copyFile(const std::string & from, const std::string & to) {
+        std::ifstream in(from.c_str(), std::ios::binary);
+        std::ofstream out(to.c_str(), std::ios::binary | std::ios::trunc);
+        if(!in.is_open() || !out.is_open()) {
+            return false;
+        }
+        out << in.rdbuf();
+        out.close();
+        return !out.fail();
+    }
+};
+
+#endif
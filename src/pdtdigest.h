@@ -0,0 +1,73 @@
+#ifndef __PDTDIGEST_H__
+#define __PDTDIGEST_H__
+
+#include <string>
+#include <cstdio>
+
+#include <gcrypt.h>
+
+// Incremental SHA-256 digest (libgcrypt). Used where a collision would give
+// a wrong result rather than a slower one, e.g. PDB cache keys; PDTHash is
+// enough for in-memory identities.
+class PDTDigest {
+public:
+    PDTDigest() : md(NULL) {
+        if(!gcry_control(GCRYCTL_INITIALIZATION_FINISHED_P)) {
+            gcry_check_version(NULL);
+            gcry_control(GCRYCTL_DISABLE_SECMEM, 0);
+            gcry_control(GCRYCTL_INITIALIZATION_FINISHED, 0);
+        }
+        if(gcry_md_open(&md, GCRY_MD_SHA256, 0) != 0) {
+            md = NULL;
+        }
+    };
+
+    ~PDTDigest() {
+        if(md != NULL) {
+            gcry_md_close(md);
+        }
+    }
+
+    // False if libgcrypt couldn't provide SHA-256.
+    bool isValid(void) const {
+        return md != NULL;
+    }
+
+    PDTDigest & add(const char * data, size_t len) {
+        if(md != NULL) {
+            gcry_md_write(md, data, len);
+        }
+        return *this;
+    }
+
+    PDTDigest & add(const std::string & s) {
+        // Terminate each string so that ("ab","c") and ("a","bc") differ.
+        add(s.data(), s.size());
+        const char sep = '\0';
+        return add(&sep, 1);
+    }
+
+    const std::string hexString(void) const {
+        if(md == NULL) {
+            return "";
+        }
+        const unsigned char * digest = gcry_md_read(md, GCRY_MD_SHA256);
+        const unsigned int len = gcry_md_get_algo_dlen(GCRY_MD_SHA256);
+        std::string result;
+        for(unsigned int i = 0; i < len; ++i) {
+            char buf[3];
+            snprintf(buf, sizeof(buf), "%02x", digest[i]);
+            result += buf;
+        }
+        return result;
+    }
+
+private:
+    gcry_md_hd_t md;
+
+    // Not copyable: owns the libgcrypt handle.
+    PDTDigest(const PDTDigest &);
+    PDTDigest & operator=(const PDTDigest &);
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef __PDTHASH_H__
+#define __PDTHASH_H__
+
+#include <string>
+#include <cstdio>
+#include <stdint.h>
+
+// Incremental 64-bit FNV-1a hash. Used where PDB contents or entity keys
+// need a compact, stable identity (e.g. merging PDB files).
+class PDTHash {
+public:
+    explicit PDTHash(uint64_t seed = 14695981039346656037ULL) : h(seed) {};
+
+    PDTHash & add(const char * data, size_t len) {
+        for(size_t i = 0; i < len; ++i) {
+            h ^= static_cast<unsigned char>(data[i]);
+            h *= 1099511628211ULL;
+        }
+        return *this;
+    }
+
+    PDTHash & add(const std::string & s) {
+        // Terminate each string so that ("ab","c") and ("a","bc") differ.
+        add(s.data(), s.size());
+        const char sep = '\0';
+        return add(&sep, 1);
+    }
+
+    uint64_t value(void) const {
+        return h;
+    }
+
+    const std::string hexString(void) const {
+        char buf[17];
+        snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(h));
+        return std::string(buf);
+    }
+
+private:
+    uint64_t h;
+};
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef __PDTMEMORY_H__
+#define __PDTMEMORY_H__
+
+#include <new>
+#include <cstddef>
+
+#include <sys/resource.h>
+
+// Allocation accounting for the PDB entity classes. The class-specific
+// operator new and delete of each class (see MemoryAccounted below and
+// PooledEntity in pdtpool.h) count the live objects and bytes of its
+// category. The counts are reported by -pdtStats.
+enum MemoryCategory {
+    MEM_SOURCE_FILE,
+    MEM_COMMENT,
+    MEM_STATEMENT,
+    MEM_ROUTINE,
+    MEM_ROUTINE_CALL,
+    MEM_TYPE,
+    MEM_ARGUMENT_TYPE,
+    MEM_ENUM_ENTRY,
+    MEM_GROUP,
+    MEM_BASE_GROUP,
+    MEM_MEMBER_FUNCTION,
+    MEM_MEMBER,
+    MEM_TEMPLATE,
+    MEM_TEMPLATE_PARAMETER,
+    MEM_TEMPLATE_SPECIALIZATION_PARAMETER,
+    MEM_NAMESPACE,
+    MEM_NAMESPACE_MEMBER,
+    MEM_MACRO,
+    MEM_PRAGMA,
+    MEM_NUM_CATEGORIES
+};
+
+const char * memoryCategoryNames[MEM_NUM_CATEGORIES] = {
+    "SourceFile",
+    "Comment",
+    "Statement",
+    "Routine",
+    "RoutineCall",
+    "Type",
+    "ArgumentType",
+    "EnumEntry",
+    "Group",
+    "BaseGroup",
+    "MemberFunction",
+    "Member",
+    "Template",
+    "TemplateParameter",
+    "TemplateSpecializationParameter",
+    "Namespace",
+    "NamespaceMember",
+    "Macro",
+    "Pragma"
+};
+
+class MemoryCounters {
+public:
+    long objects;       // live objects
+    long bytes;         // live bytes (object sizes only)
+    long peakBytes;
+    long allocations;   // objects ever allocated
+
+    MemoryCounters() : objects(0), bytes(0), peakBytes(0), allocations(0) {};
+};
+
+MemoryCounters memoryCounters[MEM_NUM_CATEGORIES];
+
+inline void countMemoryAllocation(int category, size_t size) {
+    MemoryCounters & c = memoryCounters[category];
+    ++c.objects;
+    ++c.allocations;
+    c.bytes += size;
+    if(c.bytes > c.peakBytes) {
+        c.peakBytes = c.bytes;
+    }
+}
+
+inline void countMemoryRelease(int category, size_t size) {
+    MemoryCounters & c = memoryCounters[category];
+    --c.objects;
+    c.bytes -= size;
+}
+
+// Accounting only; the pooled entity classes use PooledEntity (pdtpool.h),
+// which does the same accounting.
+template<int Category>
+class MemoryAccounted {
+public:
+    static void * operator new(size_t size) {
+        void * p = ::operator new(size);
+        countMemoryAllocation(Category, size);
+        return p;
+    }
+
+    static void operator delete(void * p, size_t size) {
+        if(p != NULL) {
+            countMemoryRelease(Category, size);
+        }
+        ::operator delete(p);
+    }
+};
+
+// Peak resident set size of the process so far, in kilobytes.
+inline long peakRSSKilobytes(void) {
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // bytes on Mac OS X
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef __PDTPOOL_H__
+#define __PDTPOOL_H__
+
+#include <new>
+#include <vector>
+#include <cstddef>
+
+#include "pdtmemory.h"
+
+// Arena allocation for the PDB entity objects of one translation unit.
+//
+// Each entity class derives from PooledEntity<category, class>, whose
+// operator new hands out slots from the TypedPool of that class. Slots are
+// carved from large chunks, and deleted objects' slots are reused, so the
+// traversal doesn't go to malloc for every location, statement or call.
+// releaseEntityPools() destroys whatever objects are still alive and frees
+// all chunks at once; resetGlobalState() calls it between translation
+// units so that batch and server runs don't keep growing.
+
+class EntityPool {
+public:
+    virtual ~EntityPool() {};
+    virtual void release(void) = 0;
+};
+
+std::vector<EntityPool*> entityPools;
+
+template<typename T>
+class TypedPool : public EntityPool {
+public:
+    enum { SLOTS_PER_CHUNK = 1024 };
+
+    TypedPool(int c) : category(c), freeList(NULL), chunkUsed(SLOTS_PER_CHUNK) {
+        entityPools.push_back(this);
+    };
+
+    void * allocate(void) {
+        Slot * slot = freeList;
+        if(slot != NULL) {
+            freeList = slot->nextFree;
+        } else {
+            if(chunkUsed == SLOTS_PER_CHUNK) {
+                chunks.push_back(new Slot[SLOTS_PER_CHUNK]);
+                chunkUsed = 0;
+            }
+            slot = &chunks.back()[chunkUsed++];
+        }
+        slot->live = true;
+        slot->nextFree = NULL;
+        return slot->storage.bytes;
+    }
+
+    void deallocate(void * p) {
+        // storage is the first member, so the object and its slot share
+        // an address.
+        Slot * slot = static_cast<Slot *>(p);
+        slot->live = false;
+        slot->nextFree = freeList;
+        freeList = slot;
+    }
+
+    void release(void) {
+        for(size_t c = 0; c < chunks.size(); ++c) {
+            const size_t used = (c + 1 == chunks.size()) ? chunkUsed : static_cast<size_t>(SLOTS_PER_CHUNK);
+            for(size_t i = 0; i < used; ++i) {
+                Slot & slot = chunks[c][i];
+                if(slot.live) {
+                    reinterpret_cast<T *>(slot.storage.bytes)->~T();
+                    countMemoryRelease(category, sizeof(T));
+                }
+            }
+            delete [] chunks[c];
+        }
+        chunks.clear();
+        freeList = NULL;
+        chunkUsed = SLOTS_PER_CHUNK;
+    }
+
+private:
+    struct Slot {
+        // Aligned for anything an entity class holds.
+        union {
+            char bytes[sizeof(T)];
+            double d;
+            long long ll;
+            void * p;
+        } storage;
+        Slot * nextFree;
+        bool live;
+    };
+
+    int category;
+    std::vector<Slot *> chunks;
+    Slot * freeList;
+    size_t chunkUsed;   // slots handed out from chunks.back()
+};
+
+template<int Category, typename T>
+class PooledEntity {
+public:
+    static void * operator new(size_t size) {
+        countMemoryAllocation(Category, size);
+        if(size != sizeof(T)) {
+            return ::operator new(size);
+        }
+        return pool().allocate();
+    }
+
+    static void operator delete(void * p, size_t size) {
+        if(p == NULL) {
+            return;
+        }
+        countMemoryRelease(Category, size);
+        if(size != sizeof(T)) {
+            ::operator delete(p);
+        } else {
+            pool().deallocate(p);
+        }
+    }
+
+private:
+    static TypedPool<T> & pool(void) {
+        static TypedPool<T> * p = new TypedPool<T>(Category);
+        return *p;
+    }
+};
+
+// Destroys all pooled entity objects and frees their memory.
+inline void releaseEntityPools(void) {
+    for(std::vector<EntityPool*>::iterator it = entityPools.begin(); it != entityPools.end(); ++it) {
+        (*it)->release();
+    }
+}
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef __PDTPROFILE_H__
+#define __PDTPROFILE_H__
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+
+#include <time.h>
+
+#include "rose.h"
+
+// Per-node-kind profile of the AST traversal (-pdtProfile=<file>).
+//
+// For each Sage node class this counts the nodes visited and the time
+// spent in evaluateInheritedAttribute and evaluateSynthesizedAttribute,
+// and the calls to and time spent in handleType, handleTemplate and
+// handleFunctionType while visiting nodes of that class. Handler times
+// are inclusive: handleType time includes the handleFunctionType calls
+// it makes, and recursive calls of a handler are only timed once.
+class VisitProfile {
+public:
+    enum Visit { INHERITED, SYNTHESIZED, NUM_VISITS };
+    enum Handler { HANDLE_TYPE, HANDLE_TEMPLATE, HANDLE_FUNCTION_TYPE, NUM_HANDLERS };
+
+    struct Counters {
+        unsigned long visits[NUM_VISITS];
+        double visitSeconds[NUM_VISITS];
+        unsigned long calls[NUM_HANDLERS];
+        double handlerSeconds[NUM_HANDLERS];
+
+        double total(void) const {
+            return visitSeconds[INHERITED] + visitSeconds[SYNTHESIZED];
+        }
+    };
+
+    bool enabled;
+    // Index of the node class being visited, or V_SgNumVariants outside
+    // the traversal.
+    size_t current;
+    int handlerDepth[NUM_HANDLERS];
+
+    VisitProfile() : enabled(false), current(V_SgNumVariants) {
+        clear();
+    };
+
+    void reset(bool enable) {
+        enabled = enable;
+        clear();
+    }
+
+    Counters & counters(size_t variant) {
+        return table[variant];
+    }
+
+    static double now(void) {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + ts.tv_nsec / 1e9;
+    }
+
+    // Writes the profile, most expensive node classes first.
+    void write(const std::string & outName) const {
+        if(!enabled) {
+            return;
+        }
+        std::ofstream out(outName.c_str(), std::ios::trunc);
+        if(!out.is_open()) {
+            std::cerr << "WARNING: Unable to write traversal profile to " << outName << std::endl;
+            return;
+        }
+
+        std::vector<std::pair<double, size_t> > order;
+        for(size_t v = 0; v <= V_SgNumVariants; ++v) {
+            const Counters & c = table[v];
+            if(c.visits[INHERITED] > 0 || c.visits[SYNTHESIZED] > 0 || c.calls[HANDLE_TYPE] > 0
+               || c.calls[HANDLE_TEMPLATE] > 0 || c.calls[HANDLE_FUNCTION_TYPE] > 0) {
+                order.push_back(std::make_pair(-c.total(), v));
+            }
+        }
+        std::sort(order.begin(), order.end());
+
+        // Handler columns are outermost calls and their inclusive time.
+        char line[256];
+        snprintf(line, sizeof(line), "%-40s %10s %10s %10s %18s %18s %18s\n", "# node class", "visits",
+                 "inh(s)", "syn(s)", "handleType", "handleTemplate", "handleFunctionType");
+        out << line;
+        Counters sum = Counters();
+        for(std::vector<std::pair<double, size_t> >::const_iterator it = order.begin(); it != order.end(); ++it) {
+            const size_t v = it->second;
+            const Counters & c = table[v];
+            const std::string name = v == V_SgNumVariants ? "(outside traversal)" : getVariantName(static_cast<VariantT>(v));
+            out << formatRow(name, c);
+            for(int i = 0; i < NUM_VISITS; ++i) {
+                sum.visits[i] += c.visits[i];
+                sum.visitSeconds[i] += c.visitSeconds[i];
+            }
+            for(int i = 0; i < NUM_HANDLERS; ++i) {
+                sum.calls[i] += c.calls[i];
+                sum.handlerSeconds[i] += c.handlerSeconds[i];
+            }
+        }
+        out << formatRow("# total", sum);
+    }
+
+private:
+    Counters table[V_SgNumVariants + 1];
+
+    void clear(void) {
+        current = V_SgNumVariants;
+        for(size_t v = 0; v <= V_SgNumVariants; ++v) {
+            table[v] = Counters();
+        }
+        for(int i = 0; i < NUM_HANDLERS; ++i) {
+            handlerDepth[i] = 0;
+        }
+    }
+
+    static std::string formatRow(const std::string & name, const Counters & c) {
+        char line[256];
+        snprintf(line, sizeof(line), "%-40s %10lu %10.4f %10.4f %8lu %9.4f %8lu %9.4f %8lu %9.4f\n", name.c_str(),
+                 c.visits[INHERITED], c.visitSeconds[INHERITED], c.visitSeconds[SYNTHESIZED],
+                 c.calls[HANDLE_TYPE], c.handlerSeconds[HANDLE_TYPE],
+                 c.calls[HANDLE_TEMPLATE], c.handlerSeconds[HANDLE_TEMPLATE],
+                 c.calls[HANDLE_FUNCTION_TYPE], c.handlerSeconds[HANDLE_FUNCTION_TYPE]);
+        return line;
+    }
+};
+
+VisitProfile visitProfile;
+
+// Times one evaluateInheritedAttribute or evaluateSynthesizedAttribute call.
+class VisitTimer {
+public:
+    VisitTimer(SgNode * n, VisitProfile::Visit k) : kind(k), start(0) {
+        if(visitProfile.enabled) {
+            visitProfile.current = n->variantT();
+            start = VisitProfile::now();
+        }
+    }
+
+    ~VisitTimer() {
+        if(visitProfile.enabled) {
+            VisitProfile::Counters & c = visitProfile.counters(visitProfile.current);
+            ++c.visits[kind];
+            c.visitSeconds[kind] += VisitProfile::now() - start;
+            visitProfile.current = V_SgNumVariants;
+        }
+    }
+
+private:
+    VisitProfile::Visit kind;
+    double start;
+};
+
+// Times the outermost call of a type or template handler.
+class HandlerTimer {
+public:
+    HandlerTimer(VisitProfile::Handler h) : handler(h), start(0) {
+        if(visitProfile.enabled && visitProfile.handlerDepth[handler]++ == 0) {
+            start = VisitProfile::now();
+        }
+    }
+
+    ~HandlerTimer() {
+        if(visitProfile.enabled && --visitProfile.handlerDepth[handler] == 0) {
+            VisitProfile::Counters & c = visitProfile.counters(visitProfile.current);
+            ++c.calls[handler];
+            c.handlerSeconds[handler] += VisitProfile::now() - start;
+        }
+    }
+
+private:
+    VisitProfile::Handler handler;
+    double start;
+};
+
+#endif
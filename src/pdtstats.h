@@ -0,0 +1,176 @@
+#ifndef __PDTSTATS_H__
+#define __PDTSTATS_H__
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdio>
+
+#include <sys/time.h>
+
+#include "pdtmemory.h"
+
+// Name of the report file for the PDB file pdbName. A report path ending
+// in '/' names a directory holding one <pdb name><suffix> file per PDB.
+inline std::string reportFileName(const std::string & path, const std::string & pdbName, const std::string & suffix) {
+    if(path.empty() || path[path.size() - 1] != '/') {
+        return path;
+    }
+    const std::string::size_type slash = pdbName.rfind('/');
+    return path + (slash == std::string::npos ? pdbName : pdbName.substr(slash + 1)) + suffix;
+}
+
+// Phase timings, the peak RSS at the end of each phase, entity counts and
+// entity memory (see pdtmemory.h) for one translation unit, written as
+// JSON with -pdtStats=<file>. If <file> ends in '/', the statistics are
+// written to <file><pdb name>.stats.json instead, so that batch and
+// server runs keep one file per translation unit (see reportFileName).
+class PDTStats {
+public:
+    PDTStats() : enabled(false), inPhase(false), current(0) {};
+
+    // Starts collecting for a new translation unit. Collection is off if
+    // path is empty.
+    void reset(const std::string & p) {
+        path = p;
+        enabled = !p.empty();
+        inPhase = false;
+        phases.clear();
+        phaseRSS.clear();
+        counts.clear();
+        values.clear();
+        gettimeofday(&startTime, NULL);
+    }
+
+    bool isEnabled(void) const {
+        return enabled;
+    }
+
+    // Ends the current phase, if any, and starts timing the named one.
+    void startPhase(const char * name) {
+        if(!enabled) {
+            return;
+        }
+        endPhase();
+        // A phase entered more than once accumulates its time.
+        current = phases.size();
+        for(size_t i = 0; i < phases.size(); ++i) {
+            if(phases[i].first == name) {
+                current = i;
+            }
+        }
+        if(current == phases.size()) {
+            phases.push_back(std::make_pair(std::string(name), 0.0));
+            phaseRSS.push_back(0);
+        }
+        gettimeofday(&phaseStart, NULL);
+        inPhase = true;
+    }
+
+    void endPhase(void) {
+        if(!enabled || !inPhase) {
+            return;
+        }
+        phases[current].second += secondsSince(phaseStart);
+        phaseRSS[current] = peakRSSKilobytes();
+        inPhase = false;
+    }
+
+    void setCount(const std::string & name, long count) {
+        if(enabled) {
+            counts.push_back(std::make_pair(name, count));
+        }
+    }
+
+    void setValue(const std::string & name, const std::string & value) {
+        if(enabled) {
+            values.push_back(std::make_pair(name, value));
+        }
+    }
+
+    // Writes the statistics collected for the PDB file pdbName.
+    void write(const std::string & pdbName) {
+        if(!enabled) {
+            return;
+        }
+        endPhase();
+        const std::string outName = reportFileName(path, pdbName, ".stats.json");
+        std::ofstream out(outName.c_str(), std::ios::trunc);
+        if(!out.is_open()) {
+            std::cerr << "WARNING: Unable to write statistics to " << outName << std::endl;
+            return;
+        }
+
+        out << "{\n  \"pdb\": " << quote(pdbName);
+        for(std::vector<std::pair<std::string, std::string> >::const_iterator it = values.begin(); it != values.end(); ++it) {
+            out << ",\n  " << quote(it->first) << ": " << quote(it->second);
+        }
+        out << ",\n  \"total_seconds\": " << formatSeconds(secondsSince(startTime));
+        out << ",\n  \"phases\": {";
+        for(std::vector<std::pair<std::string, double> >::const_iterator it = phases.begin(); it != phases.end(); ++it) {
+            out << (it == phases.begin() ? "\n" : ",\n") << "    " << quote(it->first) << ": " << formatSeconds(it->second);
+        }
+        out << "\n  },\n  \"peak_rss_kb\": {";
+        for(size_t i = 0; i < phaseRSS.size(); ++i) {
+            out << (i == 0 ? "\n" : ",\n") << "    " << quote(phases[i].first) << ": " << phaseRSS[i];
+        }
+        out << "\n  },\n  \"counts\": {";
+        for(std::vector<std::pair<std::string, long> >::const_iterator it = counts.begin(); it != counts.end(); ++it) {
+            out << (it == counts.begin() ? "\n" : ",\n") << "    " << quote(it->first) << ": " << it->second;
+        }
+        out << "\n  },\n  \"memory\": {";
+        for(int i = 0; i < MEM_NUM_CATEGORIES; ++i) {
+            const MemoryCounters & c = memoryCounters[i];
+            out << (i == 0 ? "\n" : ",\n") << "    " << quote(memoryCategoryNames[i]) << ": { \"objects\": " << c.objects
+                << ", \"bytes\": " << c.bytes << ", \"peak_bytes\": " << c.peakBytes
+                << ", \"allocations\": " << c.allocations << " }";
+        }
+        out << "\n  }\n}\n";
+    }
+
+private:
+    bool enabled;
+    bool inPhase;
+    size_t current;
+    std::string path;
+    struct timeval startTime;
+    struct timeval phaseStart;
+    std::vector<std::pair<std::string, double> > phases;
+    std::vector<long> phaseRSS;
+    std::vector<std::pair<std::string, long> > counts;
+    std::vector<std::pair<std::string, std::string> > values;
+
+    static double secondsSince(const struct timeval & start) {
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        return (now.tv_sec - start.tv_sec) + (now.tv_usec - start.tv_usec) / 1e6;
+    }
+
+    static std::string formatSeconds(double seconds) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.6f", seconds);
+        return buf;
+    }
+
+    static std::string quote(const std::string & s) {
+        std::string result = "\"";
+        for(std::string::const_iterator it = s.begin(); it != s.end(); ++it) {
+            const unsigned char c = *it;
+            if(c == '"' || c == '\\') {
+                result += '\\';
+                result += c;
+            } else if(c < 0x20) {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", c);
+                result += buf;
+            } else {
+                result += c;
+            }
+        }
+        return result + "\"";
+    }
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef __PDTTEXT_H__
+#define __PDTTEXT_H__
+
+#include <string>
+
+// Appends name to out in the spacing PDB type names use: a space before
+// each '(', and no space before ')' or ','. This gives the same result as
+//
+//   replace_all(name, "(", " (");
+//   replace_all(name, " )", ")");
+//   replace_all(name, " ,", ",");
+//
+// in one pass and without temporaries. Each pass replaces non-overlapping
+// matches and doesn't rescan its own output, so of several spaces before
+// a ')' or ',' only the last one is dropped.
+inline void appendNormalizedTypeName(const std::string & name, std::string & out) {
+    const size_t len = name.size();
+    out.reserve(out.size() + len + len / 8);
+    for(size_t i = 0; i < len; ++i) {
+        const char c = name[i];
+        if(c == '(') {
+            out += ' ';
+        } else if(c == ' ' && i + 1 < len && (name[i + 1] == ')' || name[i + 1] == ',')) {
+            continue;
+        }
+        out += c;
+    }
+}
+
+inline std::string normalizeTypeName(const std::string & name) {
+    std::string result;
+    appendNormalizedTypeName(name, result);
+    return result;
+}
+
+// What scrubPreprocessorText does with a newline that doesn't end a
+// continued line.
+enum LineBreaks {
+    DROP_LINE_BREAKS, LINE_BREAKS_TO_SPACES
+};
+
+// Sets out to the text of a macro, comment, pragma or template with each
+// backslash-newline replaced by a space and each other newline dropped or
+// replaced by a space. This is replace_all(text, "\\\n", " ") followed by
+// erase_all(text, "\n") or replace_all(text, "\n", " "), in one pass. out
+// keeps its storage, so it can be the entity's own string.
+inline void scrubPreprocessorText(const std::string & text, std::string & out, LineBreaks breaks) {
+    out.clear();
+    out.reserve(text.size());
+    size_t start = 0;
+    while(start < text.size()) {
+        const size_t newline = text.find('\n', start);
+        if(newline == std::string::npos) {
+            out.append(text, start, std::string::npos);
+            break;
+        }
+        if(newline > start && text[newline - 1] == '\\') {
+            out.append(text, start, newline - 1 - start);
+            out += ' ';
+        } else {
+            out.append(text, start, newline - start);
+            if(breaks == LINE_BREAKS_TO_SPACES) {
+                out += ' ';
+            }
+        }
+        start = newline + 1;
+    }
+}
+
+#endif
@@ -9,44 +9,57 @@
 
 
 #include "rose.h"
+#include "pdtpool.h"
+#include "intern.h"
 
 #include "sourcefile.h"
 
-class SourceLocation;
-
+// Files in the order we first saw a location in them; the so# entries are
+// written in this order.
 std::vector<SourceFile*> files;
-std::map<int, SourceLocation*> foundLocations;
 
+// Which file IDs are in files, indexed by ID + FILE_ID_OFFSET. ROSE's
+// special file IDs (compiler generated, transformation, ...) are small
+// negative numbers.
+const int FILE_ID_OFFSET = 8;
+std::vector<bool> seenFileIds;
+
+// A position in a source file, stored by value in the entity that has it.
+// A default-constructed location is "no location" and is written as
+// NULL 0 0, as are compiler-generated ones.
 class SourceLocation {
 public:
 	int fileId;
 	int line;
-	int column;
-	bool cgen;
-		
-	SourceLocation(int f, int l, int c) : fileId(f), line(l), column(c), cgen(false) {};
-	
-	SourceLocation(Sg_File_Info const * file) : fileId(file->get_file_id() + 1), 
-												line(file->get_raw_line()), 
-												column(file->get_raw_col()),
-												cgen(file->isCompilerGenerated()) {
-													if(foundLocations.count(fileId) == 0) {
-														// First time we've seen this file.
-														foundLocations[fileId] = this;
-														files.push_back(new SourceFile(fileId, file->get_raw_filename()));
-													}
-												};
-	
+	signed int column : 30;
+	unsigned int cgen : 1;
+	unsigned int valid : 1;
+
+	SourceLocation() : fileId(0), line(0), column(0), cgen(false), valid(false) {};
+
+	SourceLocation(int f, int l, int c) : fileId(f), line(l), column(c), cgen(false), valid(true) {};
+
+	// Doesn't register the file; see makeLocation.
+	explicit SourceLocation(Sg_File_Info const * file) : fileId(file->get_file_id() + 1),
+													line(file->get_raw_line()),
+													column(file->get_raw_col()),
+													cgen(file->isCompilerGenerated()),
+													valid(true) {};
+
+	bool isValid(void) const {
+		return valid;
+	}
+
 	const std::string locationString(void) const {
 		std::stringstream s;
-		if(this == NULL || cgen) {
+		if(!valid || cgen) {
 			s << "NULL 0 0";
 		} else {
 			s << "so#" << fileId << " " << line << " " << column;
 		}
 		return s.str();
 	}
-	
+
 	friend std::ostream & operator<<(std::ostream & out, const SourceLocation & loc);
 };
 
@@ -55,4 +68,31 @@ std::ostream & operator<<(std::ostream & out, const SourceLocation & loc) {
 	return out;
 }
 
+// Adds the file of file to files the first time we see it.
+void registerSourceFile(Sg_File_Info const * file) {
+	const int fileId = file->get_file_id() + 1;
+	const int index = fileId + FILE_ID_OFFSET;
+	if(index < 0) {
+		// Not expected from ROSE; fall back to the map of files.
+		if(sourceFileMap.count(fileId) == 0) {
+			files.push_back(new SourceFile(fileId, file->get_raw_filename()));
+		}
+		return;
+	}
+	if(static_cast<size_t>(index) >= seenFileIds.size()) {
+		seenFileIds.resize(2 * index + 1, false);
+	}
+	if(!seenFileIds[index]) {
+		// First time we've seen this file.
+		seenFileIds[index] = true;
+		files.push_back(new SourceFile(fileId, file->get_raw_filename()));
+	}
+}
+
+// The location of file, registering its file.
+inline SourceLocation makeLocation(Sg_File_Info const * file) {
+	registerSourceFile(file);
+	return SourceLocation(file);
+}
+
 #endif
@@ -19,16 +19,16 @@
 #include "rose.h"
 #include "pdtutil.h"
 
-class Pragma {
+class Pragma : public PooledEntity<MEM_PRAGMA, Pragma> {
 public:
 	int id;
-	SourceLocation * ploc;
-	SourceLocation * ppos_start;
-	SourceLocation * ppos_end;
+	SourceLocation ploc;
+	SourceLocation ppos_start;
+	SourceLocation ppos_end;
 	std::string ptext;
 	
-	Pragma(int i = -1, SourceLocation * l = NULL, SourceLocation * ps = NULL, 
-		  SourceLocation * pe = NULL, std::string t = "") 
+	Pragma(int i = -1, const SourceLocation & l = SourceLocation(), const SourceLocation & ps = SourceLocation(), 
+		  const SourceLocation & pe = SourceLocation(), std::string t = "") 
 			: id(i), ploc(l), ppos_start(ps), ppos_end(pe), ptext(t) {};
 
 	const std::string pragmaString(void) const {
@@ -37,20 +37,20 @@ public:
 		s << "pr#" << id << "\n";
 		
 		s << "ploc ";
-		if(ploc != NULL) {
-			s << (*ploc) << "\n";
+		if(ploc.isValid()) {
+			s << ploc << "\n";
 		} else {
 			s << "NULL 0 0\n";
 		}
 		
 		s << "ppos ";
-		if(ppos_start != NULL) {
-			s << (*ppos_start) << " ";
+		if(ppos_start.isValid()) {
+			s << ppos_start << " ";
 		} else {
 			s << "NULL 0 0 ";
 		}
-		if(ppos_end != NULL) {
-			s << (*ppos_end) << "\n";
+		if(ppos_end.isValid()) {
+			s << ppos_end << "\n";
 		} else {
 			s << "NULL 0 0\n";
 		}
@@ -0,0 +1,109 @@
+#ifndef __PTRMAP_H__
+#define __PTRMAP_H__
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+#include <stdint.h>
+
+// Hash map keyed by pointer, for looking up the entry we made for a Sage
+// node without building a string key for it. Uses open addressing with
+// linear probing in a power-of-two table that is kept at most half full.
+// NULL is not a valid key: it marks empty slots, so looking it up would
+// return an empty slot's value. Entries can't be removed individually;
+// clear() empties the map.
+template<typename K, typename V>
+class PtrMap {
+public:
+    PtrMap() : used(0) {
+        slots.resize(MIN_CAPACITY);
+    };
+
+    size_t size(void) const {
+        return used;
+    }
+
+    // Returns the value stored for key, or NULL if there is none.
+    V * find(const K * key) {
+        assert(key != NULL);
+        Slot & s = slots[probe(key)];
+        return s.key == key ? &s.value : NULL;
+    }
+
+    const V * find(const K * key) const {
+        assert(key != NULL);
+        const Slot & s = slots[probe(key)];
+        return s.key == key ? &s.value : NULL;
+    }
+
+    // Stores value for key, replacing any value already stored.
+    void insert(const K * key, const V & value) {
+        (*this)[key] = value;
+    }
+
+    // Returns the value stored for key, inserting a default value if there
+    // is none.
+    V & operator[](const K * key) {
+        assert(key != NULL);
+        size_t i = probe(key);
+        if(slots[i].key != key) {
+            if(2 * (used + 1) > slots.size()) {
+                grow();
+                i = probe(key);
+            }
+            slots[i].key = key;
+            slots[i].value = V();
+            ++used;
+        }
+        return slots[i].value;
+    }
+
+    void clear(void) {
+        std::vector<Slot>(MIN_CAPACITY).swap(slots);
+        used = 0;
+    }
+
+private:
+    enum { MIN_CAPACITY = 64 };
+
+    struct Slot {
+        const K * key;
+        V value;
+
+        Slot() : key(NULL), value() {};
+    };
+
+    std::vector<Slot> slots;
+    size_t used;
+
+    static size_t hash(const K * key) {
+        // Drop the alignment bits, then mix (Fibonacci hashing).
+        uint64_t h = (reinterpret_cast<uintptr_t>(key) >> 3) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+
+    // Index of key's slot, or of the empty slot where it would go.
+    size_t probe(const K * key) const {
+        const size_t mask = slots.size() - 1;
+        size_t i = hash(key) & mask;
+        while(slots[i].key != NULL && slots[i].key != key) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void grow(void) {
+        std::vector<Slot> old(slots.size() * 2);
+        old.swap(slots);
+        for(typename std::vector<Slot>::const_iterator it = old.begin(); it != old.end(); ++it) {
+            if(it->key != NULL) {
+                Slot & s = slots[probe(it->key)];
+                s.key = it->key;
+                s.value = it->value;
+            }
+        }
+    }
+};
+
+#endif
@@ -93,26 +93,26 @@
 #include <string>
 #include <vector>
 
-class RoutineCall {
+class RoutineCall : public PooledEntity<MEM_ROUTINE_CALL, RoutineCall> {
 public:
     int id;
-    SourceLocation * loc;
+    SourceLocation loc;
     SgFunctionDefinition * sgRoutine;
 	bool virt;
 
-    RoutineCall(int i = -1, SourceLocation * l = NULL, SgFunctionDefinition * d = NULL) :
+    RoutineCall(int i = -1, const SourceLocation & l = SourceLocation(), SgFunctionDefinition * d = NULL) :
         id(i), loc(l), sgRoutine(d), virt(false) {};
 };
 
-class Routine {
+class Routine : public PooledEntity<MEM_ROUTINE, Routine> {
 public:
 
     SgFunctionDefinition * node;
 	bool fortran;
 
 	int id;
-	std::string name;
-	SourceLocation * rloc;
+	InternedString name;
+	SourceLocation rloc;
 	//int rgroup;
 	//accessType access;
 	int rnspace;
@@ -155,26 +155,26 @@ public:
 	bool rrec;
 	bool riselem;
 
-	SourceLocation * rstart;
+	SourceLocation rstart;
 
     std::vector<RoutineCall *> rcalls;
 
-	SourceLocation * rpos_rtype;
-	SourceLocation * rpos_endDecl;
-	SourceLocation * rpos_startBlock;
-	SourceLocation * rpos_endBlock;
+	SourceLocation rpos_rtype;
+	SourceLocation rpos_endDecl;
+	SourceLocation rpos_startBlock;
+	SourceLocation rpos_endBlock;
 	
 	std::vector<Statement*> rstmts;
 	int rbody;
 	
 
-	Routine(int i, SgFunctionDefinition * nd, std::string n) : node(nd), fortran(false), id(i), name(n), rloc(NULL), rnspace(-1), rsig(-1), 
+	Routine(int i, SgFunctionDefinition * nd, std::string n) : node(nd), fortran(false), id(i), name(n), rloc(), rnspace(-1), rsig(-1), 
                                                                stmtId(0), rlink(NO), rkind(NA), rstatic(false),
                                                                rskind(NONE), rvirt(VIRT_NO), rcrvo(false),
                                                                rinline(false), rcgen(false), rexpl(false), 
 															   rtempl(-1), rspecl(false), rarginfo(false), rrec(false), 
-															   riselem(false), rstart(NULL), rpos_rtype(NULL),
-                                                               rpos_endDecl(NULL), rpos_startBlock(NULL), rpos_endBlock(NULL),
+															   riselem(false), rstart(), rpos_rtype(),
+                                                               rpos_endDecl(), rpos_startBlock(), rpos_endBlock(),
                                                                rstmts(), rbody(-1) {};
 	
 	friend std::ostream & operator<<(std::ostream & out, const Routine & r);
@@ -182,8 +182,8 @@ public:
 	const std::string routineString(void) const {
 		std::stringstream s;
 		s << "ro#" << id << " " << name << "\n";
-		if(rloc != NULL) {
-			s << "rloc " << *rloc << "\n";
+		if(rloc.isValid()) {
+			s << "rloc " << rloc << "\n";
 		}
 
         if(rnspace > 0) {
@@ -284,8 +284,8 @@ public:
 		
 		if(fortran) {
 			s << "rstart ";
-			if(rstart != NULL) {
-				s << (*rstart) << "\n";
+			if(rstart.isValid()) {
+				s << rstart << "\n";
 			} else {
 				s << "NULL 0 0\n";
 			}
@@ -293,7 +293,7 @@ public:
 		
         for(std::vector<RoutineCall*>::const_iterator it = rcalls.begin(); it!=rcalls.end(); ++it) {
             RoutineCall * rcall = *it;
-            SourceLocation * rcloc = rcall->loc;
+            const SourceLocation & rcloc = rcall->loc;
             if(rcall->id < 0) {
                 //std::cerr << "WARNING: rcall has invalid id" << std::endl;
             } else {
@@ -303,10 +303,10 @@ public:
 				} else {
 					s << "no ";
 				}
-	            if(rcloc == NULL) {
+	            if(!rcloc.isValid()) {
 	                s << "NULL 0 0";
 	            } else {
-	                s << *rcloc;
+	                s << rcloc;
 	            }
 	            s << "\n";
 			}
@@ -320,20 +320,20 @@ public:
 			s << "rbody st#" << rbody << "\n";
 		}
 		
-		if(rpos_rtype != NULL) {
-			s << "rpos " << (*rpos_rtype);
-            if(rpos_endDecl != NULL) {
-			    s << " " << (*rpos_endDecl);
+		if(rpos_rtype.isValid()) {
+			s << "rpos " << rpos_rtype;
+            if(rpos_endDecl.isValid()) {
+			    s << " " << rpos_endDecl;
             } else {
                 s << " NULL 0 0";
             }
-            if(rpos_startBlock != NULL) {
-			    s << " " << (*rpos_startBlock);
+            if(rpos_startBlock.isValid()) {
+			    s << " " << rpos_startBlock;
             } else {
                 s << " NULL 0 0";
             }
-            if(rpos_endBlock != NULL) {
-			    s << " " << (*rpos_endBlock);
+            if(rpos_endBlock.isValid()) {
+			    s << " " << rpos_endBlock;
             } else {
                 s << " NULL 0 0";
             }
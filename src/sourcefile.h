@@ -8,13 +8,15 @@
 #include <vector>
 
 #include "rose.h"
+#include "pdtpool.h"
+#include "intern.h"
 
 class SourceFile;
 class SourceLocation;
 
 std::map<int, SourceFile*> sourceFileMap;
 
-class Comment {
+class Comment : public PooledEntity<MEM_COMMENT, Comment> {
 public:
 	int id;
 	Language lang;
@@ -27,10 +29,10 @@ public:
 			start(s), end(e), text(t) {};
 };
 
-class SourceFile {
+class SourceFile : public PooledEntity<MEM_SOURCE_FILE, SourceFile> {
 public:
 	int fileId;
-	std::string path;
+	InternedString path;
 	bool ssys;
 	std::vector<int> sinc;
 	std::vector<Comment*> scoms;
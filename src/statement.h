@@ -42,16 +42,12 @@
 #include <sstream>
 #include <string>
 
-class Statement {
+class Statement : public PooledEntity<MEM_STATEMENT, Statement> {
 public:
 
-    SgStatement * node;
-
 	int id;
     int depth;
 
-	bool fortran;
-	
 	enum StatementType {
 		// C, C++
 		STMT_NONE, STMT_IGNORE, STMT_SWITCH, STMT_CASE, STMT_INIT, STMT_RETURN, STMT_IF, STMT_EMPTY,
@@ -73,22 +69,17 @@ public:
 	
 	StatementType kind;
 	
-	SourceLocation * start;
-	SourceLocation * end;
+	SourceLocation start;
+	SourceLocation end;
 	int next;
     int down;
     int extra;
     int affinity;
 
-    SgStatement * nextSgStmt;
-    SgStatement * downSgStmt;
-    SgStatement * extraSgStmt;
-    SgExpression * affinitySgExpr;
+	bool fortran;
 	
-	Statement(int i, SgStatement * n, StatementType k = STMT_NONE) : node(n), id(i), depth(-1), fortran(false),
-                                                                     kind(k), start(NULL), end(NULL), next(-1), down(-1),
-                                                                     extra(-1), affinity(-1), nextSgStmt(NULL), downSgStmt(NULL),
-                                                                     extraSgStmt(NULL), affinitySgExpr(NULL) {};
+	Statement(int i, StatementType k = STMT_NONE) : id(i), depth(-1), kind(k), start(), end(), next(-1), down(-1),
+                                                    extra(-1), affinity(-1), fortran(false) {};
 	
 	friend std::ostream & operator<<(std::ostream & out, const Statement & s);
 	
@@ -152,17 +143,17 @@ public:
 		} 
 		s << " ";
 		
-		if(start == NULL) {
+		if(!start.isValid()) {
 			s << "NULL 0 0";
 		} else {
-			s << *start;
+			s << start;
 		}
 		s << " ";
 		
-		if(end == NULL) {
+		if(!end.isValid()) {
 			s << "NULL 0 0";
 		} else {
-			s << *end;
+			s << end;
 		}
 		s << " ";
 		
@@ -232,5 +223,22 @@ std::ostream & operator<<(std::ostream & out, const Statement & s) {
 	return out;
 }
 
+// The Sage statements that a Statement's next, down and extra links refer to.
+// These are only needed until the fixups after the traversal have turned
+// them into statement IDs, so they are kept in a separate table that is
+// dropped then rather than in every Statement.
+class StatementLinks {
+public:
+    SgStatement * next;
+    SgStatement * down;
+    SgStatement * extra;
+
+    StatementLinks() : next(NULL), down(NULL), extra(NULL) {};
+
+    bool empty(void) const {
+        return next == NULL && down == NULL && extra == NULL;
+    }
+};
+
 #endif
 
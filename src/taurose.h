@@ -46,18 +46,5 @@ class SynthesizedAttribute {
                         SynthesizedAttribute(const SynthesizedAttribute & X) : next(X.next), down(X.down) {}; 
 };
 
-class PDTAttribute : public AstAttribute {
-    public:
-            Statement * statement;
-            Routine * routine;
-            Statement * gotoStmt;
-            Group * group;
-
-            PDTAttribute(Statement * s = NULL, Routine * r = NULL, Statement * g = NULL,
-                         Group * gr = NULL) : statement(s), routine(r), gotoStmt(NULL), group(gr) {}; 
-            PDTAttribute(const PDTAttribute & X) : statement(X.statement), routine(X.routine), 
-                                                   gotoStmt(X.gotoStmt), group(X.group) {}; 
-};
-
 #endif
 
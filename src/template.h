@@ -10,7 +10,7 @@
 #include "rose.h"
 #include "pdtutil.h"
 
-class TemplateParameter {
+class TemplateParameter : public PooledEntity<MEM_TEMPLATE_PARAMETER, TemplateParameter> {
 public:
 	enum TemplateParameterKind {
 		TPARAM_NA, TPARAM_TYPE, TPARAM_NTYPE, TPARAM_TEMPL
@@ -30,7 +30,8 @@ public:
 					  id(i), id_group(ig), name(n), defaultValue(dv), defaultId(d), defaultId_group(dg) {};
 };
 
-class TemplateSpecializationParameter {
+class TemplateSpecializationParameter : public PooledEntity<MEM_TEMPLATE_SPECIALIZATION_PARAMETER,
+                                                         TemplateSpecializationParameter> {
 public:
 	enum TemplateSpecializationParameterKind {
 		TSPARAM_NA, TSPARAM_TYPE, TSPARAM_NTYPE, TSPARAM_TEMPL
@@ -46,15 +47,15 @@ public:
 									id_group(g), constant(c) {};
 };
 
-class Template {
+class Template : public PooledEntity<MEM_TEMPLATE, Template> {
 	
 public:
 	int id;
-	std::string name;
+	InternedString name;
 	
 	SgTemplateDeclaration * sgTemplateDeclaration;
 	
-	SourceLocation * tloc;
+	SourceLocation tloc;
 	
 	int tgroup;
 	enum TemplateGroupAccess {
@@ -82,16 +83,16 @@ public:
 	
 	std::string ttext;
 	
-	SourceLocation * tpos_templateToken;
-	SourceLocation * tpos_tokenEnd;
-	SourceLocation * tpos_templateStart;
-	SourceLocation * tpos_templateEnd;
+	SourceLocation tpos_templateToken;
+	SourceLocation tpos_tokenEnd;
+	SourceLocation tpos_templateStart;
+	SourceLocation tpos_templateEnd;
 	
 	Template(int i = -1, std::string n = "-") 
 		: id(i), name(n), sgTemplateDeclaration(NULL), tgroup(-1), tacs(T_ACS_NA),
 		  tnspace(-1), tdecl(-1), tdef(-1), tkind(TKIND_NA), tproto(-1), ttype(-1), ttype_group(false),
-		  ttext(""), tpos_templateToken(NULL), tpos_tokenEnd(NULL), tpos_templateStart(NULL),
-		  tpos_templateEnd(NULL) {};
+		  ttext(""), tpos_templateToken(), tpos_tokenEnd(), tpos_templateStart(),
+		  tpos_templateEnd() {};
 			
     
 	
@@ -102,8 +103,8 @@ public:
 		
 		s << "te#" << id << " " << name << "\n";
 		
-		if(tloc != NULL) {
-			s << "tloc " << (*tloc) << "\n";
+		if(tloc.isValid()) {
+			s << "tloc " << tloc << "\n";
 		}
 		
 		if(tgroup > 0) {
@@ -250,26 +251,26 @@ public:
 		
 		s << "tpos ";
 
-        if(tpos_templateToken != NULL) {
-            s << *(tpos_templateToken) << " ";
+        if(tpos_templateToken.isValid()) {
+            s << tpos_templateToken << " ";
         } else {
             s << "NULL 0 0 ";
         }
 
-        if(tpos_tokenEnd != NULL) {
-            s << *(tpos_tokenEnd) << " ";
+        if(tpos_tokenEnd.isValid()) {
+            s << tpos_tokenEnd << " ";
         } else {
             s << "NULL 0 0 ";
         }
         
-        if(tpos_templateStart != NULL) {
-            s << *(tpos_templateStart) << " ";
+        if(tpos_templateStart.isValid()) {
+            s << tpos_templateStart << " ";
         } else {
             s << "NULL 0 0 ";
         }
 
-        if(tpos_templateEnd != NULL) {
-            s << *(tpos_templateEnd);
+        if(tpos_templateEnd.isValid()) {
+            s << tpos_templateEnd;
         } else {
             s << "NULL 0 0 ";
         }
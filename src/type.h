@@ -106,17 +106,17 @@
 
 class Type;
 
-class ArgumentType {
+class ArgumentType : public PooledEntity<MEM_ARGUMENT_TYPE, ArgumentType> {
 public:	
 	int id;
     bool group;
 	std::string name;
-	SourceLocation * location;
+	SourceLocation location;
 	
-	ArgumentType(int i, bool g, std::string n, SourceLocation * l = NULL) : id(i), group(g), name(n), location(l) {};
+	ArgumentType(int i, bool g, std::string n, const SourceLocation & l = SourceLocation()) : id(i), group(g), name(n), location(l) {};
 };
 
-class EnumEntry {
+class EnumEntry : public PooledEntity<MEM_ENUM_ENTRY, EnumEntry> {
 public:
 	std::string name;
 	int value;
@@ -124,12 +124,12 @@ public:
 	EnumEntry(std::string n, int v) : name(n), value(v) {};
 };
 
-class Type {
+class Type : public PooledEntity<MEM_TYPE, Type> {
 public:
 	int id;
 	bool fortran;
-	std::string name;
-	SourceLocation * yloc;
+	InternedString name;
+	SourceLocation yloc;
 	//ygroup
 	//yacs
 	int ynspace;
@@ -212,7 +212,7 @@ public:
 
 	friend std::ostream & operator<<(std::ostream & out, const Type & t);
 
-	Type(int i, std::string n) : id(i), fortran(false), name(n), yloc(NULL), ynspace(-1), ykind(NA), yikind(INT_NA), ysigned(false),
+	Type(int i, std::string n) : id(i), fortran(false), name(n), yloc(), ynspace(-1), ykind(NA), yikind(INT_NA), ysigned(false),
 								 lastEnumValue(0), yfkind(FLOAT_NA), yptr(-1), yref(-1), yrett(-1), yellip(false),
 								 yqual(false), yelem(-1), yelem_group(false), ystat(false), ynelem(-3),
 								 yshape(AS_NA), yrank(-1), ydim(""),
@@ -339,7 +339,7 @@ public:
 				}
 				for(std::vector<ArgumentType*>::const_iterator it = yargts.begin(); it!=yargts.end(); ++it) {
                     std::string yargt_flag = (*it)->group ? "gr#" : "ty#";
-					s << "yargt " << yargt_flag << (*it)->id << " " << (*it)->name << " " << *(*it)->location << "\n";
+					s << "yargt " << yargt_flag << (*it)->id << " " << (*it)->name << " " << (*it)->location << "\n";
 				}
 				if(yellip) {
 					s << "yellip T\n";